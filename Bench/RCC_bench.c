@@ -0,0 +1,450 @@
+/*
+ * RCC_bench - register traffic and timing benchmark of the RCC driver (Linux host).
+ *
+ * Runs each public function against the simulated RCC_RegDef_t of Sim/RCC_sim.c and
+ * reports, per call, the volatile reads and writes, host nanoseconds and the estimated
+ * Cortex-M4 cycles (bus cost model of RCC_sim.h plus a fixed call overhead).
+ *
+ * Build:  gcc -std=c99 -O2 -DRCC_HOST_SIM -IInc -I. -ISim -o RCC_bench \
+ *             Bench/RCC_bench.c Sim/RCC_sim.c Src/RCC_prog.c Src/RCC_energy.c
+ * Usage:  RCC_bench [--json] [--check baseline.csv] [--record prefix]
+ *         RCC_bench --faults
+ *         RCC_bench --energy
+ *
+ * The default output is CSV. With --check the run is compared against a previous CSV
+ * output and the exit status is 1 if any function does more reads or writes.
+ * With --record the measured call of every function is also written as a register
+ * access trace to <prefix><function>.rct, to be compared with Tools/RCC_tracediff.
+ *
+ * --faults runs the failure scenarios instead: each one scripts a simulator fault,
+ * applies the bench image and reports the result, the register traffic and the
+ * estimated recovery time at the 16 MHz HSI clock. The exit status is 1 if a scenario
+ * returns an unexpected result or does not leave the core on a running clock.
+ *
+ * --energy applies a set of clock configurations, takes an RCC_GetClkState() snapshot
+ * of each and prints its RCC_Energy_Estimate() breakdown, ranking the configurations.
+ * The exit status is 1 if the estimates do not order as the model requires (a faster
+ * clock draws more, a bypassed oscillator draws nothing, Sleep-gated peripherals only
+ * lower the Sleep current).
+ */
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "RCC_interface.h"
+#include "RCC_energy.h"
+#include "RCC_sim.h"
+
+#define BENCH_ITERATIONS      20000U
+#define BENCH_CALL_CYCLES     12U     // Call, prologue/epilogue, argument check and return
+#define BENCH_MAX_RESULTS     64U
+#define BENCH_HSI_MHZ         16U     // Clock the recovery paths run from
+
+typedef void (*BENCH_PREPARE_t)(void);
+typedef void (*BENCH_RUN_t)(void);
+
+typedef struct
+{
+    const char     *Name;
+    BENCH_PREPARE_t Prepare;   // Puts the simulator in the state the call expects
+    BENCH_RUN_t     Run;       // One call of the function under test
+
+}BENCH_CASE_t;
+
+typedef struct
+{
+    const char *Name;
+    uint32_t    Reads;
+    uint32_t    Writes;
+    double      HostNs;
+    uint64_t    EstCycles;
+
+}BENCH_RESULT_t;
+
+/* 8 MHz HSE -> 168 MHz, the image RCC_clkgen emits for the NUCLEO example board */
+static const RCC_IMAGE_t BenchImage = {
+    0x01050000UL, 0x27402A04UL, 0x00009402UL, 0, 0,
+    0x00200007UL, 0x00000080UL, 0, 0x10020000UL, 0x00004000UL,
+    0x00000705UL, 0
+};
+
+/* BenchImage with an HSE crystal instead of the ST-LINK bypass clock */
+static const RCC_IMAGE_t EnergyImage168 = {
+    0x01010000UL, 0x27402A04UL, 0x00009402UL, 0, 0,
+    0x00200007UL, 0x00000080UL, 0, 0x10020000UL, 0x00004000UL,
+    0x00000705UL, 0
+};
+
+/* Same crystal and enables at 84 MHz: P=4, APB1 /2, APB2 /1, 2 wait states */
+static const RCC_IMAGE_t EnergyImage84 = {
+    0x01010000UL, 0x27412A04UL, 0x00001002UL, 0, 0,
+    0x00200007UL, 0x00000080UL, 0, 0x10020000UL, 0x00004000UL,
+    0x00000702UL, 0
+};
+
+/* Same PLL as BenchImage: M=4 N=168 P=2 Q=7 R=2 from HSE */
+static const PLL_CONFIG_t BenchPLL = {2, 7, 2, 168, 4, HSE};
+
+static void PrepareReset(void) {
+    RCCSim_Reset();
+}
+
+static void PrepareHSEOn(void) {
+    RCCSim_Reset();
+    (void)RCC_SetClkStatus(HSE, ON);
+}
+
+static void PreparePLLOn(void) {
+    PrepareHSEOn();
+    (void)RCC_PLL_Config(168, 4, HSE);
+}
+
+static void PrepareBackup(void) {
+    RCCSim_Reset();
+    (void)RCC_BackupAccess(ON);
+}
+
+static void PrepareLSIOn(void) {
+    RCCSim_Reset();
+    (void)RCC_LSI_SetStatus(ON);
+}
+
+static void RunSetClkStatus(void)   { (void)RCC_SetClkStatus(HSE, ON); }
+static void RunSetSysClk(void)      { (void)RCC_SetSysClk(SYSPLLP); }
+static void RunHSEMode(void)        { (void)RCC_HSE_Mode(BYPASSED); }
+static void RunPLLConfig(void)      { (void)RCC_PLL_Config(168, 4, HSE); }
+static void RunPLLSetConfig(void)   { (void)RCC_PLL_SetConfig(&BenchPLL); }
+static void RunGetSysClkFreq(void)  { (void)RCC_GetSysClkFreq(); }
+static void RunGetClkState(void)    { RCC_CLK_STATE_t State; (void)RCC_GetClkState(&State); }
+static void RunPLLRRoute(void)      { (void)RCC_PLLR_RouteKernel(PLLR_SAI1, ON); }
+static void RunBackupAccess(void)   { (void)RCC_BackupAccess(ON); }
+static void RunLSEStart(void)       { (void)RCC_LSE_Start(0); }
+static void RunRTCConfig(void)      { (void)RCC_RTC_Config(RTC_LSE, 0); }
+static void RunMeasureLSI(void)     { RCC_MEAS_RESULT_t Result; (void)RCC_MeasureClk(MEAS_LSI, 8, &Result); }
+static void RunGroupEnable(void)    { (void)RCC_Group_Enable(&RCC_GROUP_SDIO); }
+static void RunLoadImage(void)      { (void)RCC_LoadImage(&BenchImage); }
+static void RunEarlyInit(void)      { RCC_EarlyInit(); }
+static void RunCSSStatus(void)      { (void)RCC_SetCSSStatus(ON); }
+static void RunAHB1Enable(void)     { (void)RCC_AHB1_EnableClk(GPIOAEN); }
+static void RunAHB1Disable(void)    { (void)RCC_AHB1_DisableClk(GPIOAEN); }
+static void RunAHB2Enable(void)     { (void)RCC_AHB2_EnableClk(OTGFSEN); }
+static void RunAHB2Disable(void)    { (void)RCC_AHB2_DisableClk(OTGFSEN); }
+static void RunAHB3Enable(void)     { (void)RCC_AHB3_EnableClk(QSPIEN); }
+static void RunAHB3Disable(void)    { (void)RCC_AHB3_DisableClk(QSPIEN); }
+static void RunAPB1Enable(void)     { (void)RCC_APB1_EnableClk(USART2EN); }
+static void RunAPB1Disable(void)    { (void)RCC_APB1_DisableClk(USART2EN); }
+static void RunAPB2Enable(void)     { (void)RCC_APB2_EnableClk(TIM1EN); }
+static void RunAPB2Disable(void)    { (void)RCC_APB2_DisableClk(TIM1EN); }
+
+static const BENCH_CASE_t Cases[] = {
+    {"RCC_SetClkStatus",    PrepareReset,  RunSetClkStatus},
+    {"RCC_SetSysClk",       PreparePLLOn,  RunSetSysClk},
+    {"RCC_GetSysClkFreq",   PreparePLLOn,  RunGetSysClkFreq},
+    {"RCC_GetClkState",     PreparePLLOn,  RunGetClkState},
+    {"RCC_HSE_Mode",        PrepareReset,  RunHSEMode},
+    {"RCC_PLL_Config",      PrepareHSEOn,  RunPLLConfig},
+    {"RCC_PLL_SetConfig",   PrepareHSEOn,  RunPLLSetConfig},
+    {"RCC_PLLR_RouteKernel",PrepareReset,  RunPLLRRoute},
+    {"RCC_LoadImage",       PrepareReset,  RunLoadImage},
+    {"RCC_EarlyInit",       PrepareReset,  RunEarlyInit},
+    {"RCC_SetCSSStatus",    PrepareReset,  RunCSSStatus},
+    {"RCC_BackupAccess",    PrepareReset,  RunBackupAccess},
+    {"RCC_LSE_Start",       PrepareBackup, RunLSEStart},
+    {"RCC_RTC_Config",      PrepareBackup, RunRTCConfig},
+    {"RCC_MeasureClk",      PrepareLSIOn,  RunMeasureLSI},
+    {"RCC_Group_Enable",    PrepareReset,  RunGroupEnable},
+    {"RCC_AHB1_EnableClk",  PrepareReset,  RunAHB1Enable},
+    {"RCC_AHB1_DisableClk", PrepareReset,  RunAHB1Disable},
+    {"RCC_AHB2_EnableClk",  PrepareReset,  RunAHB2Enable},
+    {"RCC_AHB2_DisableClk", PrepareReset,  RunAHB2Disable},
+    {"RCC_AHB3_EnableClk",  PrepareReset,  RunAHB3Enable},
+    {"RCC_AHB3_DisableClk", PrepareReset,  RunAHB3Disable},
+    {"RCC_APB1_EnableClk",  PrepareReset,  RunAPB1Enable},
+    {"RCC_APB1_DisableClk", PrepareReset,  RunAPB1Disable},
+    {"RCC_APB2_EnableClk",  PrepareReset,  RunAPB2Enable},
+    {"RCC_APB2_DisableClk", PrepareReset,  RunAPB2Disable},
+};
+
+#define CASE_COUNT    (sizeof(Cases) / sizeof(Cases[0]))
+
+typedef struct
+{
+    const char     *Name;
+    RCCSIM_FAULT_t  Fault;
+    uint8_t         CSSOn;      // Enable the clock security system before loading
+    uint8_t         Expected;   // Expected RCC_LoadImage() result
+
+}BENCH_FAULT_CASE_t;
+
+#define CR_REG      (&RCCSim_Regs.Rcc.CR)
+#define CFGR_REG    (&RCCSim_Regs.Rcc.CFGR)
+#define ACR_REG     (&RCCSim_Regs.Flash.ACR)
+
+static const BENCH_FAULT_CASE_t FaultCases[] = {
+    {"none",             {RCCSIM_FAULT_FLIP,      CR_REG,   0,           0},    0, 0},
+    {"hse_never_ready",  {RCCSIM_FAULT_STUCK_LOW, CR_REG,   1UL << 17,   0},    0, 1},
+    {"hse_late_ready",   {RCCSIM_FAULT_DELAY,     CR_REG,   1UL << 17,   2000}, 0, 0},
+    {"pll_never_locks",  {RCCSIM_FAULT_STUCK_LOW, CR_REG,   1UL << 25,   0},    0, 1},
+    {"pll_late_lock",    {RCCSIM_FAULT_DELAY,     CR_REG,   1UL << 25,   5000}, 0, 0},
+    {"sws_stuck_hsi",    {RCCSIM_FAULT_STUCK_LOW, CFGR_REG, 0x3UL << 2,  0},    0, 1},
+    {"acr_readback_flip",{RCCSIM_FAULT_FLIP,      ACR_REG,  0x1UL,       1},    0, 0},
+    {"css_during_load",  {RCCSIM_FAULT_CSS,       NULL,     0,           12},   1, 1},
+};
+
+#define FAULT_CASE_COUNT    (sizeof(FaultCases) / sizeof(FaultCases[0]))
+
+typedef struct
+{
+    const char        *Name;
+    const RCC_IMAGE_t *Image;       // NULL: stay in the reset clock state
+    uint8_t            Lse;         // 0: LSE off, 1: crystal, 2: bypass
+    uint8_t            SleepGated;  // Clear every LPENR bit before the snapshot
+
+}BENCH_ENERGY_CASE_t;
+
+/* RunEnergyCases() checks the estimates by these positions */
+static const BENCH_ENERGY_CASE_t EnergyCases[] = {
+    {"reset_hsi_16mhz",         NULL,            0, 0},
+    {"hse_xtal_84mhz",          &EnergyImage84,  0, 0},
+    {"hse_xtal_168mhz",         &EnergyImage168, 0, 0},
+    {"hse_bypass_168mhz",       &BenchImage,     0, 0},
+    {"hse_xtal_168mhz_lse_xtal",&EnergyImage168, 1, 0},
+    {"hse_xtal_168mhz_lse_byp", &EnergyImage168, 2, 0},
+    {"hse_xtal_168mhz_lpenr_0", &EnergyImage168, 0, 1},
+};
+
+#define ENERGY_CASE_COUNT    (sizeof(EnergyCases) / sizeof(EnergyCases[0]))
+
+static double NowNs(void) {
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec * 1e9 + (double)Ts.tv_nsec;
+}
+
+/**
+ * @brief Measures one case: counters from a single call, time averaged over many.
+ */
+static void RunCase(const BENCH_CASE_t *Case, BENCH_RESULT_t *Result, const char *RecordPrefix) {
+    const RCCSIM_COUNTERS_t *Cnt = RCCSim_GetCounters();
+    double                   Start;
+    double                   Total = 0.0;
+    uint32_t                 Iter;
+    char                     Path[256];
+
+    Case->Prepare();
+    RCCSim_ClearCounters();
+    if (RecordPrefix != NULL) {
+        snprintf(Path, sizeof(Path), "%s%s.rct", RecordPrefix, Case->Name);
+        if (RCCSim_TraceOpen(Path) != 0) {
+            fprintf(stderr, "cannot create trace %s\n", Path);
+        }
+    }
+    Case->Run();
+    RCCSim_TraceClose();
+    Result->Name = Case->Name;
+    Result->Reads = Cnt->Reads;
+    Result->Writes = Cnt->Writes;
+    Result->EstCycles = Cnt->Cycles + BENCH_CALL_CYCLES;
+
+    for (Iter = 0; Iter < BENCH_ITERATIONS; Iter++) {
+        Case->Prepare();
+        Start = NowNs();
+        Case->Run();
+        Total += NowNs() - Start;
+    }
+    Result->HostNs = Total / BENCH_ITERATIONS;
+}
+
+/**
+ * @brief Compares the run with a baseline CSV; returns the number of regressions.
+ */
+static int CheckBaseline(const char *File, const BENCH_RESULT_t *Results, size_t Count) {
+    char     Line[256];
+    char     Name[64];
+    unsigned Reads;
+    unsigned Writes;
+    int      Regressions = 0;
+    size_t   Idx;
+    FILE    *In = fopen(File, "r");
+
+    if (In == NULL) {
+        fprintf(stderr, "cannot open baseline %s\n", File);
+        return 1;
+    }
+    while (fgets(Line, sizeof(Line), In) != NULL) {
+        if (sscanf(Line, "%63[^,],%u,%u", Name, &Reads, &Writes) != 3) {
+            continue;  // Header or malformed line
+        }
+        for (Idx = 0; Idx < Count; Idx++) {
+            if (strcmp(Results[Idx].Name, Name) != 0) {
+                continue;
+            }
+            if (Results[Idx].Reads > Reads || Results[Idx].Writes > Writes) {
+                fprintf(stderr, "REGRESSION %s: reads %u -> %u, writes %u -> %u\n", Name,
+                        Reads, (unsigned)Results[Idx].Reads, Writes, (unsigned)Results[Idx].Writes);
+                Regressions++;
+            }
+        }
+    }
+    fclose(In);
+    return Regressions;
+}
+
+/**
+ * @brief Runs the fault scenarios; returns the number of failed ones.
+ */
+static int RunFaultCases(void) {
+    const RCCSIM_COUNTERS_t *Cnt = RCCSim_GetCounters();
+    const BENCH_FAULT_CASE_t *Case;
+    uint8_t                  Result;
+    uint8_t                  Running;
+    int                      Failures = 0;
+    size_t                   Idx;
+
+    printf("scenario,result,expected,reads,writes,est_cycles,est_us_hsi,clock_ok\n");
+    for (Idx = 0; Idx < FAULT_CASE_COUNT; Idx++) {
+        Case = &FaultCases[Idx];
+        RCCSim_Reset();
+        if (Case->CSSOn) {
+            (void)RCC_SetCSSStatus(ON);
+        }
+        if (Case->Fault.Mask != 0 || Case->Fault.Type == RCCSIM_FAULT_CSS) {
+            (void)RCCSim_InjectFault(&Case->Fault);
+        }
+        RCCSim_ClearCounters();
+
+        Result = RCC_LoadImage(&BenchImage);
+
+        // Whatever happened, SYSCLK must come from a source that is running
+        switch ((RCCSim_Regs.Rcc.CFGR >> 2) & 0x3) {
+            case 0:  Running = (RCCSim_Regs.Rcc.CR >> 1) & 1;  break;
+            case 1:  Running = (RCCSim_Regs.Rcc.CR >> 17) & 1; break;
+            default: Running = (RCCSim_Regs.Rcc.CR >> 25) & 1; break;
+        }
+        if (Result != Case->Expected || !Running) {
+            Failures++;
+        }
+        printf("%s,%u,%u,%u,%u,%llu,%.1f,%u\n", Case->Name, Result, Case->Expected,
+               (unsigned)Cnt->Reads, (unsigned)Cnt->Writes, (unsigned long long)Cnt->Cycles,
+               (double)Cnt->Cycles / BENCH_HSI_MHZ, Running);
+    }
+    return Failures;
+}
+
+/**
+ * @brief Reports a failed energy model check; returns 1 if Cond is false.
+ */
+static int EnergyExpect(int Cond, const char *What) {
+    if (!Cond) {
+        fprintf(stderr, "ENERGY CHECK FAILED: %s\n", What);
+    }
+    return Cond ? 0 : 1;
+}
+
+/**
+ * @brief Estimates the supply current of each energy scenario; returns the number of
+ *        failed model checks.
+ */
+static int RunEnergyCases(void) {
+    const BENCH_ENERGY_CASE_t *Case;
+    RCC_CLK_STATE_t            State;
+    RCC_ENERGY_t               Est[ENERGY_CASE_COUNT];
+    int                        Failures = 0;
+    size_t                     Idx;
+
+    printf("scenario,hclk_mhz,run_ua,core_ua,osc_ua,periph_ua,sleep_ua\n");
+    for (Idx = 0; Idx < ENERGY_CASE_COUNT; Idx++) {
+        Case = &EnergyCases[Idx];
+        memset(&State, 0, sizeof(State));
+        RCCSim_Reset();
+        if (Case->Image != NULL && RCC_LoadImage(Case->Image) != 0) {
+            Failures += EnergyExpect(0, Case->Name);
+        }
+        if (Case->Lse != 0) {
+            (void)RCC_BackupAccess(ON);
+            (void)RCC_LSE_SetMode((Case->Lse == 2) ? LSE_BYPASS : LSE_LOW_DRIVE);
+            (void)RCC_LSE_Start(0);
+        }
+        if (Case->SleepGated) {
+            RCCSim_Regs.Rcc.AHB1LPENR = 0;
+            RCCSim_Regs.Rcc.AHB2LPENR = 0;
+            RCCSim_Regs.Rcc.AHB3LPENR = 0;
+            RCCSim_Regs.Rcc.APB1LPENR = 0;
+            RCCSim_Regs.Rcc.APB2LPENR = 0;
+        }
+        if (RCC_GetClkState(&State) != 0 || RCC_Energy_Estimate(&State, &Est[Idx]) != 0) {
+            Failures += EnergyExpect(0, Case->Name);
+            memset(&Est[Idx], 0, sizeof(Est[Idx]));
+        }
+        printf("%s,%u,%u,%u,%u,%u,%u\n", Case->Name, (unsigned)(State.HClk / 1000000UL),
+               (unsigned)Est[Idx].RunUa, (unsigned)Est[Idx].CoreUa, (unsigned)Est[Idx].OscUa,
+               (unsigned)Est[Idx].PeriphUa, (unsigned)Est[Idx].SleepUa);
+    }
+
+    Failures += EnergyExpect(Est[0].RunUa < Est[1].RunUa && Est[1].RunUa < Est[2].RunUa,
+                             "Run current rises with HCLK");
+    Failures += EnergyExpect(Est[2].OscUa - Est[3].OscUa == RCC_ENERGY_HSE_UA,
+                             "a bypassed HSE draws no crystal current");
+    Failures += EnergyExpect(Est[4].OscUa - Est[2].OscUa == RCC_ENERGY_LSE_UA,
+                             "an LSE crystal adds RCC_ENERGY_LSE_UA");
+    Failures += EnergyExpect(Est[5].OscUa == Est[2].OscUa,
+                             "a bypassed LSE draws no crystal current");
+    Failures += EnergyExpect(Est[6].RunUa == Est[2].RunUa && Est[6].SleepUa < Est[2].SleepUa,
+                             "LPENR gating lowers only the Sleep current");
+    return Failures;
+}
+
+int main(int argc, char **argv) {
+    BENCH_RESULT_t Results[BENCH_MAX_RESULTS];
+    const char    *Baseline = NULL;
+    const char    *RecordPrefix = NULL;
+    int            Json = 0;
+    int            Arg;
+    size_t         Idx;
+
+    for (Arg = 1; Arg < argc; Arg++) {
+        if (strcmp(argv[Arg], "--faults") == 0) {
+            return (RunFaultCases() != 0) ? 1 : 0;
+        } else if (strcmp(argv[Arg], "--energy") == 0) {
+            return (RunEnergyCases() != 0) ? 1 : 0;
+        } else if (strcmp(argv[Arg], "--json") == 0) {
+            Json = 1;
+        } else if (strcmp(argv[Arg], "--check") == 0 && Arg + 1 < argc) {
+            Baseline = argv[++Arg];
+        } else if (strcmp(argv[Arg], "--record") == 0 && Arg + 1 < argc) {
+            RecordPrefix = argv[++Arg];
+        } else {
+            fprintf(stderr, "usage: %s [--json] [--check baseline.csv] [--record prefix] | --faults | --energy\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (Idx = 0; Idx < CASE_COUNT; Idx++) {
+        RunCase(&Cases[Idx], &Results[Idx], RecordPrefix);
+    }
+
+    if (Json) {
+        printf("[\n");
+        for (Idx = 0; Idx < CASE_COUNT; Idx++) {
+            printf("  {\"function\": \"%s\", \"reads\": %u, \"writes\": %u, \"host_ns\": %.1f, \"est_cycles\": %llu}%s\n",
+                   Results[Idx].Name, (unsigned)Results[Idx].Reads, (unsigned)Results[Idx].Writes,
+                   Results[Idx].HostNs, (unsigned long long)Results[Idx].EstCycles,
+                   (Idx + 1 < CASE_COUNT) ? "," : "");
+        }
+        printf("]\n");
+    } else {
+        printf("function,reads,writes,host_ns,est_cycles\n");
+        for (Idx = 0; Idx < CASE_COUNT; Idx++) {
+            printf("%s,%u,%u,%.1f,%llu\n", Results[Idx].Name, (unsigned)Results[Idx].Reads,
+                   (unsigned)Results[Idx].Writes, Results[Idx].HostNs,
+                   (unsigned long long)Results[Idx].EstCycles);
+        }
+    }
+
+    if (Baseline != NULL && CheckBaseline(Baseline, Results, CASE_COUNT) != 0) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,306 @@
+/*
+ * RCC_stopbench - Stop-mode wake-up latency benchmark of the RCC restore path (target).
+ *
+ * Each sample enters Stop with the core on the run-mode image, wakes on RTC alarm A
+ * and brings the clocks back the way the application does: RCC_SetClkStatus(HSE),
+ * RCC_SetClkStatus(PLL), then RCC_LoadImage() for over-drive, flash latency, the
+ * SYSCLK switch and the bus enables. Three latencies are taken from the alarm:
+ *
+ *   WakeToHsi  alarm to the first instruction after WFI, from RTC_SSR. The core
+ *              clocks are stopped in Stop, so this one has the 30.5 us resolution of
+ *              the LSE-driven sub-second counter.
+ *   WakeToHse  WakeToHsi plus the DWT CYCCNT cycles (at 16 MHz HSI) to HSERDY.
+ *   WakeToPll  WakeToHsi plus the DWT CYCCNT cycles (at 16 MHz HSI) to PLLRDY.
+ *
+ * PLLCFGR keeps its value through Stop, so the PLL restarts with the image factors;
+ * RCC_LoadImage() keeps the locked PLL without touching PLLCFGR and applies only the
+ * remaining steps. HSI runs within its 1 % factory trim, which bounds the error of
+ * the cycle to nanosecond conversion.
+ *
+ * Build:  link Bench/RCC_stopbench.c with Src/RCC_prog.c into the application
+ *         (arm-none-eabi-gcc -mcpu=cortex-m4 -mthumb -IInc -I. -IBench ...).
+ *         There is no host build: Stop mode cannot be simulated.
+ *
+ * Requirements: backup domain access (RCC_BackupAccess(ON)), LSE running and the RTC
+ * clocked from it (RCC_RTC_Config(RTC_LSE, 0)). Run without a debugger holding the
+ * clocks in Stop (DBGMCU_CR DBG_STOP clear), otherwise CYCCNT keeps counting.
+ * The RTC prescaler is set to PREDIV_A=0, PREDIV_S=32767 for the run (the calendar
+ * keeps its 1 Hz rate) and every RTC, EXTI, PWR and SysTick setting is restored after.
+ */
+#include <stdint.h>
+#include "RCC_interface.h"
+#include "STM32F446xx.h"
+#include "RCC_stopbench.h"
+
+#define RCC         ((RCC_RegDef_t*)RCC_BASE_ADDRESS)
+#define PWR         ((PWR_RegDef_t*)PWR_BASE_ADDRESS)
+#define RTC         ((RTC_RegDef_t*)RTC_BASE_ADDRESS)
+#define EXTI        ((EXTI_RegDef_t*)EXTI_BASE_ADDRESS)
+#define NVIC        ((NVIC_RegDef_t*)NVIC_BASE_ADDRESS)
+#define SCB         ((SCB_RegDef_t*)SCB_BASE_ADDRESS)
+#define DWT         ((DWT_RegDef_t*)DWT_BASE_ADDRESS)
+#define COREDEBUG   ((CoreDebug_RegDef_t*)COREDEBUG_BASE_ADDRESS)
+#define SYSTICK     ((SysTick_RegDef_t*)SYSTICK_BASE_ADDRESS)
+
+#define STOPBENCH_ALARM_EXTI      17U      // RTC alarm EXTI line
+#define STOPBENCH_ALARM_IRQ       41U      // RTC_Alarm_IRQn
+#define STOPBENCH_SS_BITS         10U      // Alarm compares SSR[9:0]: one match every 31.25 ms
+#define STOPBENCH_SS_MASK         ((1UL << STOPBENCH_SS_BITS) - 1)
+#define STOPBENCH_WAIT_POLLS      0x00010000UL
+
+static uint32_t StopBench_Hsi[STOPBENCH_MAX_SAMPLES];
+static uint32_t StopBench_Hse[STOPBENCH_MAX_SAMPLES];
+static uint32_t StopBench_Pll[STOPBENCH_MAX_SAMPLES];
+
+/**
+ * @brief Polls an RTC ISR flag until it is set, bounded like the driver's waits.
+ */
+static uint8_t StopBench_WaitRtc(uint32_t Flag) {
+    uint32_t Polls;
+
+    for (Polls = 0; Polls < STOPBENCH_WAIT_POLLS; Polls++) {
+        if (RTC->ISR & Flag) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Reads RTC_SSR directly (BYPSHAD set), twice to reject a read across a tick.
+ */
+static uint32_t StopBench_ReadSsr(void) {
+    uint32_t Ssr;
+
+    do {
+        Ssr = RTC->SSR;
+    } while (Ssr != RTC->SSR);
+    return Ssr;
+}
+
+/**
+ * @brief Converts HSI DWT cycles to nanoseconds.
+ */
+static uint32_t StopBench_HsiNs(uint32_t Cycles) {
+    return (uint32_t)(((uint64_t)Cycles * 1000000000ULL) / RCC_HSI_FREQ);
+}
+
+/**
+ * @brief Sorts the samples in place and summarizes them.
+ */
+static void StopBench_Summarize(uint32_t *Ns, uint16_t Count, STOPBENCH_DIST_t *Dist) {
+    uint64_t Sum = 0;
+    uint32_t Value;
+    uint16_t Idx;
+    uint16_t Pos;
+
+    for (Idx = 1; Idx < Count; Idx++) {  // Insertion sort, at most 64 samples
+        Value = Ns[Idx];
+        for (Pos = Idx; Pos > 0 && Ns[Pos - 1] > Value; Pos--) {
+            Ns[Pos] = Ns[Pos - 1];
+        }
+        Ns[Pos] = Value;
+    }
+    for (Idx = 0; Idx < Count; Idx++) {
+        Sum += Ns[Idx];
+    }
+
+    Dist->Min    = Ns[0];
+    Dist->Median = Ns[Count / 2];
+    Dist->P90    = Ns[(Count * 9U) / 10U];
+    Dist->Max    = Ns[Count - 1];
+    Dist->Mean   = (uint32_t)(Sum / Count);
+}
+
+/**
+ * @brief Arms alarm A to match SSR[9:0] SleepTicks from now.
+ *
+ * @return The SSR value the alarm matches.
+ */
+static uint32_t StopBench_ArmAlarm(uint16_t SleepTicks) {
+    uint32_t Target;
+
+    RTC->CR &= ~(1UL << 8);                                   // ALRAE off to write the alarm
+    (void)StopBench_WaitRtc(1UL << 0);                        // ALRAWF
+    Target = (StopBench_ReadSsr() - SleepTicks) & STOPBENCH_SS_MASK;  // SSR counts down
+    RTC->ALRMASSR = (STOPBENCH_SS_BITS << 24) | Target;       // MASKSS
+    RTC->ISR = ~((1U << 8) | (1U << 7));                    // Clear ALRAF, keep INIT clear
+    EXTI->PR = 1UL << STOPBENCH_ALARM_EXTI;
+    NVIC->ICPR[STOPBENCH_ALARM_IRQ / 32] = 1UL << (STOPBENCH_ALARM_IRQ % 32);
+    RTC->CR |= (1UL << 8);                                    // ALRAE
+    return Target;
+}
+
+/**
+ * @brief Measures the Stop-mode wake-up latency of the clock restore path.
+ *
+ * Interrupts are masked for the whole run: WFI still returns on the pending RTC alarm
+ * interrupt, which is never taken. A wake-up by any other pending interrupt is
+ * discarded and counted in Result->Spurious (at most one per requested sample).
+ *
+ * @param Config The image, sample count, sleep length and Stop-mode options.
+ * @param Result Receives the latency distributions in nanoseconds.
+ * @return uint8_t Returns 0 on success, 1 for an invalid argument, if the RTC is not
+ *         clocked from a running LSE or a clock failed to restart.
+ */
+uint8_t StopBench_Run(const STOPBENCH_CONFIG_t *Config, STOPBENCH_RESULT_t *Result) {
+    uint32_t Primask;
+    uint32_t SavedPrer;
+    uint32_t SavedCr;
+    uint32_t SavedAlrmar;
+    uint32_t SavedAlrmassr;
+    uint32_t SavedPwrCr;
+    uint32_t SavedSysTick;
+    uint32_t SavedImr;
+    uint32_t SavedRtsr;
+    uint32_t Target;
+    uint32_t Ssr;
+    uint32_t T0;
+    uint32_t T1;
+    uint32_t T2;
+    uint32_t HsiNs;
+    uint16_t Count = 0;
+    uint16_t Spurious = 0;
+    uint8_t  Error = 0;
+
+    if (Config == 0 || Result == 0 || Config->Image == 0 ||
+        Config->Samples == 0 || Config->Samples > STOPBENCH_MAX_SAMPLES ||
+        Config->SleepTicks < 2 || Config->SleepTicks > STOPBENCH_SS_MASK) {
+        return 1;  // Invalid argument
+    }
+    // LSE ready, RTCSEL = LSE, RTCEN and backup domain access
+    if (!RCC_LSE_IsReady() || (RCC->BDCR & ((0b11 << 8) | (1 << 15))) != ((1 << 8) | (1 << 15)) ||
+        !(PWR->CR & (1 << 8))) {
+        return 1;
+    }
+
+    __asm volatile ("mrs %0, primask" : "=r" (Primask));
+    __asm volatile ("cpsid i" ::: "memory");
+
+    COREDEBUG->DEMCR |= (1UL << 24);                         // TRCENA
+    DWT->CTRL |= (1UL << 0);                                 // CYCCNTENA
+
+    SavedSysTick = SYSTICK->CTRL;
+    SYSTICK->CTRL = SavedSysTick & ~(1UL << 1);              // TICKINT off, SysTick must not end WFI
+    SCB->ICSR = 1UL << 25;                                   // PENDSTCLR
+
+    // RTC: PREDIV_A=0 so SSR counts LSE ticks, shadow registers bypassed
+    SavedPrer     = RTC->PRER;
+    SavedCr       = RTC->CR;
+    SavedAlrmar   = RTC->ALRMAR;
+    SavedAlrmassr = RTC->ALRMASSR;
+    RTC->WPR = 0xCA;
+    RTC->WPR = 0x53;
+    RTC->ISR = ~0U;                                         // INIT, flags untouched
+    if (StopBench_WaitRtc(1UL << 6)) {                       // INITF
+        RTC->ISR = ~(1U << 7);
+        RTC->WPR = 0xFF;
+        SYSTICK->CTRL = SavedSysTick;
+        __asm volatile ("msr primask, %0" :: "r" (Primask) : "memory");
+        return 1;
+    }
+    RTC->PRER = 32767;                                       // PREDIV_S first, then PREDIV_A
+    RTC->PRER = 32767;
+    RTC->ISR = ~(1U << 7);                                  // Leave init mode
+    RTC->CR = (SavedCr & ~((1UL << 8) | (1UL << 12))) | (1UL << 5);  // BYPSHAD, alarm A off
+    (void)StopBench_WaitRtc(1UL << 0);                       // ALRAWF
+    RTC->ALRMAR = (1UL << 31) | (1UL << 23) | (1UL << 15) | (1UL << 7);  // Date, hours, minutes, seconds masked
+    RTC->CR |= (1UL << 12);                                  // ALRAIE
+
+    // Alarm interrupt through EXTI line 17, enabled in the NVIC but never taken
+    SavedImr  = EXTI->IMR;
+    SavedRtsr = EXTI->RTSR;
+    EXTI->IMR  = SavedImr | (1UL << STOPBENCH_ALARM_EXTI);
+    EXTI->RTSR = SavedRtsr | (1UL << STOPBENCH_ALARM_EXTI);
+    NVIC->ISER[STOPBENCH_ALARM_IRQ / 32] = 1UL << (STOPBENCH_ALARM_IRQ % 32);
+
+    // Stop rather than Standby, with the requested regulator and flash modes
+    SavedPwrCr = PWR->CR;
+    PWR->CR = (SavedPwrCr & ~((1UL << 1) | (1UL << 0) | (1UL << 9))) |
+              (Config->LowPowerRegulator ? (1UL << 0) : 0) |           // LPDS
+              (Config->FlashPowerDown ? (1UL << 9) : 0);               // FPDS
+
+    while (Count < Config->Samples) {
+        Target = StopBench_ArmAlarm(Config->SleepTicks);
+
+        SCB->SCR |= (1UL << 2);                              // SLEEPDEEP
+        __asm volatile ("dsb\n\twfi\n\tisb" ::: "memory");
+        Ssr = StopBench_ReadSsr();
+        T0  = DWT->CYCCNT;
+        SCB->SCR &= ~(1UL << 2);
+
+        if (!(RTC->ISR & (1UL << 8))) {                      // ALRAF: woken by something else
+            if (++Spurious > Config->Samples) {
+                Error = 1;
+                break;
+            }
+            if (((RCC->CFGR >> 2) & 0b11) != (Config->Image->CFGR & 0b11) &&
+                RCC_LoadImage(Config->Image)) {              // Stop was entered: clocks are on HSI
+                Error = 1;
+                break;
+            }
+            continue;
+        }
+
+        // Restore path, every timestamp taken while the core still runs from HSI
+        T1 = T0;
+        if (Config->Image->CR & (1 << HSE)) {
+            if (RCC_SetClkStatus(HSE, ON)) {
+                Error = 1;
+                break;
+            }
+            T1 = DWT->CYCCNT;
+        }
+        T2 = T1;
+        if (Config->Image->CR & (1 << PLL)) {
+            if (RCC_SetClkStatus(PLL, ON)) {
+                Error = 1;
+                break;
+            }
+            T2 = DWT->CYCCNT;
+        }
+        if (RCC_LoadImage(Config->Image)) {
+            Error = 1;
+            break;
+        }
+
+        HsiNs = ((Target - Ssr) & STOPBENCH_SS_MASK) * STOPBENCH_RTC_TICK_NS;
+        StopBench_Hsi[Count] = HsiNs;
+        StopBench_Hse[Count] = (Config->Image->CR & (1 << HSE)) ? HsiNs + StopBench_HsiNs(T1 - T0) : 0;
+        StopBench_Pll[Count] = (Config->Image->CR & (1 << PLL)) ? HsiNs + StopBench_HsiNs(T2 - T0) : 0;
+        Count++;
+    }
+
+    // Put back everything the run changed
+    RTC->CR &= ~((1UL << 8) | (1UL << 12));
+    (void)StopBench_WaitRtc(1UL << 0);
+    RTC->ALRMAR   = SavedAlrmar;
+    RTC->ALRMASSR = SavedAlrmassr;
+    RTC->ISR = ~0U;
+    if (!StopBench_WaitRtc(1UL << 6)) {
+        RTC->PRER = SavedPrer & 0x7FFF;
+        RTC->PRER = SavedPrer;
+    }
+    RTC->ISR = ~((1U << 8) | (1U << 7));
+    RTC->CR  = SavedCr;
+    RTC->WPR = 0xFF;                                         // Write protection back on
+    NVIC->ICER[STOPBENCH_ALARM_IRQ / 32] = 1UL << (STOPBENCH_ALARM_IRQ % 32);
+    NVIC->ICPR[STOPBENCH_ALARM_IRQ / 32] = 1UL << (STOPBENCH_ALARM_IRQ % 32);
+    EXTI->IMR  = SavedImr;
+    EXTI->RTSR = SavedRtsr;
+    EXTI->PR   = 1UL << STOPBENCH_ALARM_EXTI;
+    PWR->CR = (PWR->CR & ~((1UL << 1) | (1UL << 0) | (1UL << 9))) |
+              (SavedPwrCr & ((1UL << 1) | (1UL << 0) | (1UL << 9)));
+    SYSTICK->CTRL = SavedSysTick;
+    __asm volatile ("msr primask, %0" :: "r" (Primask) : "memory");
+
+    Result->Samples  = Count;
+    Result->Spurious = Spurious;
+    if (Error || Count == 0) {
+        return 1;
+    }
+    StopBench_Summarize(StopBench_Hsi, Count, &Result->WakeToHsi);
+    StopBench_Summarize(StopBench_Hse, Count, &Result->WakeToHse);
+    StopBench_Summarize(StopBench_Pll, Count, &Result->WakeToPll);
+    return 0;
+}
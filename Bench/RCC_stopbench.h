@@ -0,0 +1,57 @@
+#ifndef RCC_STOPBENCH_H
+#define RCC_STOPBENCH_H
+
+#include <stdint.h>
+#include "RCC_interface.h"
+
+#define STOPBENCH_MAX_SAMPLES     64U      // Wake-ups kept per run
+#define STOPBENCH_RTC_TICK_NS     30518U   // One RTC sub-second tick (1 / 32768 Hz)
+
+/********************* Stop Benchmark Configuration *********************/
+typedef struct
+{
+    const RCC_IMAGE_t *Image;        // Run-mode clock image restored after every wake-up
+    uint16_t Samples;                // Wake-ups to measure (1..STOPBENCH_MAX_SAMPLES)
+    uint16_t SleepTicks;             // Time in Stop, in RTC ticks of 30.5 us (2..1023)
+    uint8_t  LowPowerRegulator;      // Non-zero: LPDS, regulator in low-power mode during Stop
+    uint8_t  FlashPowerDown;         // Non-zero: FPDS, flash powered down during Stop
+
+}STOPBENCH_CONFIG_t;
+
+/********************* Latency Distribution (ns) *********************/
+typedef struct
+{
+    uint32_t Min;
+    uint32_t Median;
+    uint32_t P90;
+    uint32_t Max;
+    uint32_t Mean;
+
+}STOPBENCH_DIST_t;
+
+/********************* Stop Benchmark Result *********************/
+typedef struct
+{
+    uint16_t         Samples;        // Wake-ups measured
+    uint16_t         Spurious;       // Wake-ups by another interrupt, discarded
+    STOPBENCH_DIST_t WakeToHsi;      // Alarm to first instruction on HSI (RTC tick resolution)
+    STOPBENCH_DIST_t WakeToHse;      // Alarm to HSERDY (0 if the image does not use HSE)
+    STOPBENCH_DIST_t WakeToPll;      // Alarm to PLLRDY (0 if the image does not use the PLL)
+
+}STOPBENCH_RESULT_t;
+
+/**
+ * @brief Measures the Stop-mode wake-up latency of the clock restore path.
+ *
+ * This function repeatedly enters Stop, wakes on RTC alarm A (EXTI line 17) and
+ * restores Config->Image through RCC_SetClkStatus() and RCC_LoadImage(), reporting
+ * the time from the alarm to HSI, HSE ready and PLL lock. Target only.
+ *
+ * @param Config The image, sample count, sleep length and Stop-mode options.
+ * @param Result Receives the latency distributions in nanoseconds.
+ * @return 0 on success, 1 for an invalid argument, if the RTC is not clocked from a
+ *         running LSE or a clock failed to restart.
+ */
+uint8_t StopBench_Run(const STOPBENCH_CONFIG_t *Config, STOPBENCH_RESULT_t *Result);
+
+#endif // RCC_STOPBENCH_H
@@ -0,0 +1,96 @@
+#ifndef RCC_CONFIG_H
+#define RCC_CONFIG_H
+
+
+
+/********************* Board Oscillator *********************/
+/*
+ * Frequency of the HSE crystal or external clock, used to report the running
+ * frequencies (RCC_GetSysClkFreq) from the register contents.
+ */
+#ifndef RCC_HSE_FREQ
+#define RCC_HSE_FREQ             8000000UL
+#endif
+
+/*
+ * Frequency of an external I2S/SAI clock on the I2S_CKIN pin, used to report the
+ * kernel clocks selected from it (0: not fitted).
+ */
+#ifndef RCC_I2S_CKIN_FREQ
+#define RCC_I2S_CKIN_FREQ        0UL
+#endif
+
+/********************* Early Boot Clock Image (RCC_EarlyInit) *********************/
+/*
+ * Register words applied by RCC_EarlyInit() before .data/.bss are initialized.
+ * Defaults: 8 MHz HSE crystal, PLLM=4 PLLN=180 PLLP=2 PLLQ=8 PLLR=2 -> 180 MHz SYSCLK,
+ * AHB /1, APB1 /4 (45 MHz), APB2 /2 (90 MHz), 5 flash wait states and over-drive.
+ * Override them (for example with the words printed by Tools/RCC_clkgen) on the
+ * compiler command line or before this header is included.
+ */
+#ifndef RCC_EARLY_CR
+#define RCC_EARLY_CR             0x01010000UL   // HSEON | PLLON
+#endif
+
+#ifndef RCC_EARLY_PLLCFGR
+#define RCC_EARLY_PLLCFGR        0x28402D04UL   // HSE source, M=4, N=180, P=2, Q=8, R=2
+#endif
+
+#ifndef RCC_EARLY_CFGR
+#define RCC_EARLY_CFGR           0x00009402UL   // SW=PLLP, HPRE=/1, PPRE1=/4, PPRE2=/2
+#endif
+
+#ifndef RCC_EARLY_FLASH_ACR
+#define RCC_EARLY_FLASH_ACR      0x00000705UL   // 5 wait states, prefetch, I-cache, D-cache
+#endif
+
+#ifndef RCC_EARLY_OVERDRIVE
+#define RCC_EARLY_OVERDRIVE      1U             // Required above 168 MHz
+#endif
+
+/********************* Ready-Flag Timeout *********************/
+/*
+ * Number of polls of a ready/status flag before a wait gives up and the function
+ * returns 1. One poll takes 4-8 cycles, so the default bounds a wait to roughly
+ * 65-130 ms at the 16 MHz HSI reset clock (HSE start-up is typically 2 ms).
+ */
+#ifndef RCC_READY_TIMEOUT
+#define RCC_READY_TIMEOUT        0x00040000UL
+#endif
+
+/********************* SysTick Rate *********************/
+/*
+ * Non-zero: every system clock change (RCC_SetSysClk, RCC_LoadImage, a CSS fallback)
+ * reloads SysTick so it keeps ticking at RCC_SYSTICK_HZ from the new HCLK.
+ * 0: SysTick is left alone.
+ */
+#ifndef RCC_SYSTICK_HZ
+#define RCC_SYSTICK_HZ           0U
+#endif
+
+/********************* Cycle Instrumentation *********************/
+/*
+ * 1: every public function records its entry-to-exit time, failed calls included, and
+ *    every ready-wait its duration in DWT CYCCNT cycles, read back with RCC_GetStats().
+ *    RCC_DelayUs() and the stats and trace accessors are not probed.
+ * 0: the probes compile to nothing.
+ */
+#ifndef RCC_INSTRUMENTATION
+#define RCC_INSTRUMENTATION      0
+#endif
+
+/********************* Clock Event Trace *********************/
+/*
+ * 1: clock transitions are appended to the RCC_Trace ring buffer (RAM, readable by a
+ *    debugger or dumped with RCC_GetTrace()). Safe from thread and interrupt context.
+ * RCC_TRACE_DEPTH is the number of records kept and must be a power of two.
+ */
+#ifndef RCC_TRACE
+#define RCC_TRACE                0
+#endif
+
+#ifndef RCC_TRACE_DEPTH
+#define RCC_TRACE_DEPTH          64U
+#endif
+
+#endif // RCC_CONFIG_H
@@ -0,0 +1,77 @@
+#ifndef RCC_ENERGY_H
+#define RCC_ENERGY_H
+
+#include <stdint.h>
+#include "RCC_private.h"
+
+/********************* Model Coefficients *********************/
+/*
+ * APPROXIMATE typical values at 25 C and VDD = 3.3 V, rounded from the STM32F446
+ * datasheet (DS10693) Run/Sleep and peripheral current tables. They rank
+ * configurations against each other; they are not a substitute for a measurement.
+ * Override any of them with values measured on the board.
+ *
+ * Core: Run with code in flash and the ART accelerator on, Sleep with the core
+ * stopped; a fixed part plus a part proportional to HCLK, peripherals excluded.
+ */
+#ifndef RCC_ENERGY_RUN_BASE_UA
+#define RCC_ENERGY_RUN_BASE_UA        1500UL   // Leakage, regulator and flash at 0 MHz
+#endif
+
+#ifndef RCC_ENERGY_RUN_UA_PER_MHZ
+#define RCC_ENERGY_RUN_UA_PER_MHZ     110UL
+#endif
+
+#ifndef RCC_ENERGY_SLEEP_BASE_UA
+#define RCC_ENERGY_SLEEP_BASE_UA      1200UL
+#endif
+
+#ifndef RCC_ENERGY_SLEEP_UA_PER_MHZ
+#define RCC_ENERGY_SLEEP_UA_PER_MHZ   35UL
+#endif
+
+/* Oscillators and PLLs while running (drawn in Run and Sleep alike) */
+#ifndef RCC_ENERGY_HSI_UA
+#define RCC_ENERGY_HSI_UA             80UL
+#endif
+
+#ifndef RCC_ENERGY_HSE_UA
+#define RCC_ENERGY_HSE_UA             450UL    // Crystal; an HSE bypass clock counts 0
+#endif
+
+#ifndef RCC_ENERGY_PLL_UA
+#define RCC_ENERGY_PLL_UA             400UL    // Each of PLL, PLLI2S and PLLSAI
+#endif
+
+#ifndef RCC_ENERGY_LSE_UA
+#define RCC_ENERGY_LSE_UA             1UL      // Crystal, low drive; an LSE bypass clock counts 0
+#endif
+
+#ifndef RCC_ENERGY_LSI_UA
+#define RCC_ENERGY_LSI_UA             1UL
+#endif
+
+/********************* Estimated Supply Current (uA) *********************/
+typedef struct
+{
+    uint32_t RunUa;       // Total in Run mode: Core + Osc + Periph
+    uint32_t CoreUa;      // Core, flash and regulator in Run mode
+    uint32_t OscUa;       // Running oscillators and PLLs
+    uint32_t PeriphUa;    // Peripherals enabled in AHBxENR/APBxENR at their bus clock
+    uint32_t SleepUa;     // Total in Sleep mode, peripherals enabled in both ENR and LPENR
+
+} RCC_ENERGY_t;
+
+/**
+ * @brief Estimates the supply current of a clock tree state.
+ *
+ * This function applies the coefficients above to a snapshot taken by
+ * RCC_GetClkState() (on the target or on the host simulator) or filled in by hand.
+ *
+ * @param State The oscillators, peripheral enables and bus clocks to evaluate.
+ * @param Estimate Receives the Run and Sleep currents and the Run breakdown in uA.
+ * @return 0 on success, 1 if a pointer is null.
+ */
+uint8_t RCC_Energy_Estimate(const RCC_CLK_STATE_t *State, RCC_ENERGY_t *Estimate);
+
+#endif // RCC_ENERGY_H
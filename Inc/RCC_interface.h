@@ -2,6 +2,7 @@
 #define RCC_INTERFACE_H
 
 #include "RCC_private.h"
+#include "RCC_config.h"
 
 /**
  * @brief Sets the status of the specified clock.
@@ -16,11 +17,19 @@ uint8_t RCC_SetClkStatus(CLK_t Clk_Type, STATUS_t Status);
 /**
  * @brief Configures the system clock source.
  * 
- * This function selects the clock source for the system clock (HSI, HSE, or PLL).
+ * This function selects the clock source for the system clock (HSI, HSE, PLLP or PLLR)
+ * and waits until SWS confirms the switch.
  *
- * @param ClkType The type of clock source to use (HSI, HSE, PLL).
+ * @param SYSClkType The system clock source (SYSHSI, SYSHSE, SYSPLLP, SYSPLLR).
  */
-uint8_t RCC_SetSysClk(CLK_t ClkType);
+uint8_t RCC_SetSysClk(SYS_CLK_t SYSClkType);
+
+/**
+ * @brief Returns the current system clock frequency in Hz.
+ * 
+ * This function decodes SWS and PLLCFGR; HSE is taken as RCC_HSE_FREQ.
+ */
+uint32_t RCC_GetSysClkFreq(void);
 
 /**
  * @brief Configures the High-Speed External (HSE) mode.
@@ -41,6 +50,74 @@ uint8_t RCC_HSE_Mode(HSE_t HSE_MODE);
  */
 uint8_t RCC_PLL_Config(uint32_t PLL_Multiplexer,uint8_t PLL_Division ,CLK_t Src);
 
+/**
+ * @brief Programs every factor of the main PLL and its input source.
+ * 
+ * This function writes M, N, P, Q, R and the source to PLLCFGR with a single read and
+ * a single store while the PLL is stopped, then restarts the PLL and waits for lock.
+ *
+ * @param Config The PLL factors (P as the divider value 2, 4, 6 or 8).
+ */
+uint8_t RCC_PLL_SetConfig(const PLL_CONFIG_t *Config);
+
+/**
+ * @brief Picks the PLL output (PLLP or PLLR) giving the highest legal SYSCLK.
+ * 
+ * This function only computes; no register is accessed.
+ *
+ * @param Config The PLL factors.
+ * @param HSE_Freq HSE frequency in Hz, used when the PLL source is HSE.
+ * @param Output Receives SYSPLLP or SYSPLLR.
+ * @return 0 on success, 1 if neither output gives a legal SYSCLK.
+ */
+uint8_t RCC_PLL_SelectSysOutput(const PLL_CONFIG_t *Config, uint32_t HSE_Freq, SYS_CLK_t *Output);
+
+/**
+ * @brief Routes a SAI or I2S kernel clock to the main PLL R output.
+ * 
+ * This function sets the kernel source field in DCKCFGR to PLLR (ON) or back to its
+ * reset source (OFF).
+ *
+ * @param Kernel The kernel to route (PLLR_SAI1, PLLR_SAI2, PLLR_I2S1, PLLR_I2S2).
+ * @param Status ON to clock the kernel from PLLR, OFF to restore the reset source.
+ */
+uint8_t RCC_PLLR_RouteKernel(RCC_PLLR_KERNEL_t Kernel, STATUS_t Status);
+
+/**
+ * @brief Checks a full clock configuration against the STM32F446 datasheet limits.
+ * 
+ * This function validates oscillator ranges, VCO input/output, PLL dividers, bus
+ * ceilings and the 48 MHz clock without touching any register.
+ *
+ * @param Config The clock configuration to check.
+ * @return Bitmask of violated RCC_CFG_ERR_t constraints, 0 if the configuration is legal.
+ */
+uint32_t RCC_CheckClkConfig(const RCC_CLK_CONFIG_t *Config);
+
+/**
+ * @brief Applies a precomputed clock register image.
+ * 
+ * This function writes fully formed PLLCFGR, CFGR, DCKCFGR, DCKCFGR2, flash and bus
+ * enable words with the minimum number of stores, starting from the reset clock state
+ * or from a PLL already locked on the image factors (Stop wake-up).
+ *
+ * @param Image The register image, typically generated by Tools/RCC_clkgen.
+ */
+uint8_t RCC_LoadImage(const RCC_IMAGE_t *Image);
+
+/**
+ * @brief Raises the clock tree to the RCC_EARLY_* image from RCC_config.h.
+ * 
+ * This function is reset-handler safe (no initialized data, no globals; only the
+ * stack and the peripherals) and is meant to run first in SystemInit so .data/.bss
+ * initialization runs at full speed. With RCC_INSTRUMENTATION it also starts the DWT
+ * cycle counter and records its probe in RCC_Stats, which the .bss initialization
+ * that follows clears again.
+ *
+ * @return 0 on success, 1 if a clock timed out and the core stayed on HSI.
+ */
+uint8_t RCC_EarlyInit(void);
+
 /**
  * @brief Enables the clock for a specific AHB1 peripheral.
  * 
@@ -131,4 +208,286 @@ uint8_t RCC_APB2_EnableClk(RCC_APB2_PERIPHERAL_t PeripheralName);
  */
 uint8_t RCC_APB2_DisableClk(RCC_APB2_PERIPHERAL_t PeripheralName);
 
+/**
+ * @brief Enables or disables the clock security system on HSE.
+ * 
+ * This function sets or clears CSSON in RCC_CR.
+ *
+ * @param Status The status to set for the CSS (ON, OFF).
+ */
+uint8_t RCC_SetCSSStatus(STATUS_t Status);
+
+/**
+ * @brief Handles a clock security system event.
+ * 
+ * Call it from NMI_Handler; it clears the CSS flag and records the event in the trace.
+ *
+ * @return 0 if a CSS event was handled, 1 if CSS was not the NMI source.
+ */
+uint8_t RCC_CSS_IRQHandler(void);
+
+/**
+ * @brief Enables or disables write access to the backup domain.
+ * 
+ * This function enables the PWR clock and sets or clears DBP in PWR_CR; the LSE and
+ * RTC functions below need access enabled.
+ *
+ * @param Status ON to unlock BDCR, the RTC and backup SRAM, OFF to protect them.
+ */
+uint8_t RCC_BackupAccess(STATUS_t Status);
+
+/**
+ * @brief Resets the backup domain.
+ * 
+ * This function pulses BDRST; LSE stops and the RTC clock selection is cleared.
+ */
+uint8_t RCC_BackupReset(void);
+
+/**
+ * @brief Selects the LSE drive level or external clock bypass (LSE must be off).
+ *
+ * @param Mode LSE_LOW_DRIVE, LSE_HIGH_DRIVE or LSE_BYPASS.
+ */
+uint8_t RCC_LSE_SetMode(RCC_LSE_MODE_t Mode);
+
+/**
+ * @brief Starts LSE without blocking.
+ * 
+ * This function sets LSEON and returns. Completion is reported through the callback
+ * (run from RCC_IRQHandler) or by polling RCC_LSE_IsReady().
+ *
+ * @param Callback Completion function called in interrupt context, or 0 to poll.
+ */
+uint8_t RCC_LSE_Start(RCC_CALLBACK_t Callback);
+
+/**
+ * @brief Returns 1 when LSE is stable (LSERDY), 0 otherwise.
+ */
+uint8_t RCC_LSE_IsReady(void);
+
+/**
+ * @brief RCC global interrupt handler (RCC_IRQn vector).
+ * 
+ * Acknowledges the LSE ready interrupt and runs the RCC_LSE_Start() callback.
+ */
+void RCC_IRQHandler(void);
+
+/**
+ * @brief Selects the RTC clock source and enables the RTC clock.
+ * 
+ * This function writes RTCSEL and RTCEN in one store (and RTCPRE for HSE). RTCSEL can
+ * only be changed again after RCC_BackupReset().
+ *
+ * @param Src RTC_LSE, RTC_LSI or RTC_HSE.
+ * @param HSE_Div RTCPRE divider (2..31) giving 1 MHz from HSE; ignored otherwise.
+ */
+uint8_t RCC_RTC_Config(RCC_RTC_SRC_t Src, uint8_t HSE_Div);
+
+/**
+ * @brief Switches the LSI oscillator on or off and waits for LSIRDY.
+ *
+ * @param Status The status to set for LSI (ON, OFF).
+ */
+uint8_t RCC_LSI_SetStatus(STATUS_t Status);
+
+/**
+ * @brief Returns the cause(s) of the last reset as RCC_RESET_CAUSE_t flags.
+ * 
+ * This function reads and clears RCC_CSR on its first call only and returns the
+ * cached value afterwards. Test against RCC_RESET_FULL_TEST_MASK to choose between
+ * a warm boot and the full self-test.
+ */
+uint8_t RCC_GetResetCause(void);
+
+/**
+ * @brief Returns the AHB clock (HCLK) frequency in Hz, from the register contents.
+ */
+uint32_t RCC_GetHClkFreq(void);
+
+/**
+ * @brief Returns the APB1 clock (PCLK1) frequency in Hz, from the register contents.
+ */
+uint32_t RCC_GetPClk1Freq(void);
+
+/**
+ * @brief Returns the APB2 clock (PCLK2) frequency in Hz, from the register contents.
+ */
+uint32_t RCC_GetPClk2Freq(void);
+
+/**
+ * @brief Captures the oscillators, Run/Sleep peripheral enables and bus clocks.
+ * 
+ * The snapshot is the input of RCC_Energy_Estimate() (Inc/RCC_energy.h).
+ */
+uint8_t RCC_GetClkState(RCC_CLK_STATE_t *State);
+
+/**
+ * @brief Busy-waits for Us microseconds using the DWT cycle counter at the current HCLK.
+ * 
+ * The cycles-per-microsecond scale is refreshed on every clock switch done through
+ * this driver, which also reloads SysTick when RCC_SYSTICK_HZ is set.
+ */
+void RCC_DelayUs(uint32_t Us);
+
+/**
+ * @brief Selects the timer clock multiplier (DCKCFGR TIMPRE).
+ * 
+ * @param Status OFF: timers at 2 x PCLK when APB is divided; ON: timers at HCLK up to
+ *               an APB prescaler of 4, 4 x PCLK above.
+ */
+uint8_t RCC_TIMPRE_SetStatus(STATUS_t Status);
+
+/**
+ * @brief Returns the kernel clock in Hz of an APB1 timer, 0 for other peripherals.
+ */
+uint32_t RCC_APB1_GetTimerClkFreq(RCC_APB1_PERIPHERAL_t Peripheral);
+
+/**
+ * @brief Returns the kernel clock in Hz of an APB2 timer, 0 for other peripherals.
+ */
+uint32_t RCC_APB2_GetTimerClkFreq(RCC_APB2_PERIPHERAL_t Peripheral);
+
+/**
+ * @brief Measures LSI, LSE or HSE_RTC with a timer input capture.
+ * 
+ * LSI and LSE are captured on TIM5 CH4, HSE / RTCPRE on TIM11 CH1, against the timer
+ * kernel clock derived from SYSCLK. The timer clock is enabled for the call only.
+ *
+ * @param Src The clock to measure (MEAS_LSI, MEAS_LSE, MEAS_HSE_RTC).
+ * @param Periods The number of captures of RCC_MEAS_EDGES periods to average.
+ * @param Result Receives the frequency in Hz and the error against the nominal value in ppm.
+ */
+uint8_t RCC_MeasureClk(RCC_MEAS_SRC_t Src, uint32_t Periods, RCC_MEAS_RESULT_t *Result);
+
+/**
+ * @brief Measures the real SYSCLK frequency using LSE as the reference.
+ * 
+ * @param Periods The number of LSE captures of RCC_MEAS_EDGES periods to average.
+ * @param Result Receives SYSCLK in Hz and its error against RCC_GetSysClkFreq() in ppm.
+ */
+uint8_t RCC_MeasureSysClk(uint32_t Periods, RCC_MEAS_RESULT_t *Result);
+
+/**
+ * @brief Trims HSI (CR.HSITRIM) against LSE for the smallest frequency error.
+ * 
+ * SYSCLK must run from HSI, directly or through the PLL, and LSE must be running.
+ *
+ * @param Periods The number of LSE captures per measurement.
+ * @param Result Receives the trimmed SYSCLK and its remaining error in ppm.
+ */
+uint8_t RCC_HSI_Calibrate(uint32_t Periods, RCC_MEAS_RESULT_t *Result);
+
+/**
+ * @brief Periodic HSI drift correction: one measurement and at most one trim step.
+ * 
+ * @param Periods The number of LSE captures of the measurement.
+ * @param Result Receives the error measured before the correction.
+ */
+uint8_t RCC_HSI_Retrim(uint32_t Periods, RCC_MEAS_RESULT_t *Result);
+
+/**
+ * @brief Outputs a clock on MCO1 (PA8) or MCO2 (PC9) and configures the pin.
+ * 
+ * @param Src The clock and output (MCO1_HSI, MCO1_LSE, MCO1_HSE, MCO1_PLL, MCO2_SYSCLK,
+ *            MCO2_PLLI2S, MCO2_HSE, MCO2_PLL).
+ * @param Div The output prescaler (1 to 5).
+ * @param Speed The pin speed; the output frequency must not exceed its limit.
+ */
+uint8_t RCC_MCO_Config(RCC_MCO_SRC_t Src, uint8_t Div, RCC_GPIO_SPEED_t Speed);
+
+/**
+ * @brief Selects the kernel clock source of a peripheral (DCKCFGR / DCKCFGR2).
+ * 
+ * @param Kernel The peripheral kernel clock (KERNEL_SAI1 ... KERNEL_SPDIFRX).
+ * @param Src The source; it must be one the peripheral multiplexer offers.
+ */
+uint8_t RCC_Kernel_SetSource(RCC_KERNEL_t Kernel, RCC_KERNEL_SRC_t Src);
+
+/**
+ * @brief Returns the kernel clock source selected for a peripheral (KSRC_NONE if invalid).
+ */
+RCC_KERNEL_SRC_t RCC_Kernel_GetSource(RCC_KERNEL_t Kernel);
+
+/**
+ * @brief Returns the kernel clock frequency of a peripheral in Hz, 0 if its source is not running.
+ */
+uint32_t RCC_Kernel_GetFreq(RCC_KERNEL_t Kernel);
+
+/********************* Peripheral Group Presets *********************/
+extern const RCC_GROUP_t RCC_GROUP_USB_FS;       // USB OTG FS device, 48 MHz from PLLQ
+extern const RCC_GROUP_t RCC_GROUP_AUDIO_I2S2;   // I2S2 audio out with DMA1, PLLI2S for 48 kHz
+extern const RCC_GROUP_t RCC_GROUP_SDIO;         // SD card on SDIO with DMA2, clock from PLLQ
+
+/**
+ * @brief Enables every clock of a subsystem, with one read-modify-write per register.
+ * 
+ * @param Group The group descriptor (RCC_GROUP_USB_FS, ... or an application table).
+ */
+uint8_t RCC_Group_Enable(const RCC_GROUP_t *Group);
+
+/**
+ * @brief Disables the bus clocks of a subsystem; kernel clocks and PLLs are left running.
+ */
+uint8_t RCC_Group_Disable(const RCC_GROUP_t *Group);
+
+/**
+ * @brief Selects the blocks the hardware may clock-gate while idle (CKGATENR).
+ * 
+ * @param Gated OR of RCC_CKGATE_t flags or an RCC_CKGATE_PROFILE_* value; the other
+ *              blocks are clocked all the time.
+ */
+uint8_t RCC_CKGATE_SetProfile(uint8_t Gated);
+
+/**
+ * @brief Returns the blocks currently allowed to clock-gate.
+ */
+uint8_t RCC_CKGATE_GetProfile(void);
+
+/**
+ * @brief Configures spread-spectrum modulation of the main PLL.
+ * 
+ * MODPER and INCSTEP are derived from the current PLL input and PLLN. A running PLL is
+ * relocked; the call fails while the PLL drives SYSCLK.
+ *
+ * @param ModFreq The modulation frequency in Hz (up to 10 kHz).
+ * @param Depth The peak modulation depth in 0.01 % (up to 2 %), 0 to disable.
+ * @param Spread Center or down spread.
+ */
+uint8_t RCC_SSCG_Config(uint32_t ModFreq, uint16_t Depth, RCC_SSCG_SPREAD_t Spread);
+
+#if RCC_TRACE
+/**
+ * @brief Returns the clock event trace ring.
+ * 
+ * Only available when RCC_TRACE is enabled in RCC_config.h. The ring is also
+ * reachable by a debugger through the RCC_Trace symbol.
+ *
+ * @return Pointer to the live ring buffer.
+ */
+const RCC_TRACE_t *RCC_GetTrace(void);
+
+/**
+ * @brief Empties the trace ring and starts the DWT cycle counter for timestamps.
+ */
+void RCC_ResetTrace(void);
+#endif
+
+#if RCC_INSTRUMENTATION
+/**
+ * @brief Returns the cycle statistics collected since the last RCC_ResetStats().
+ * 
+ * Only available when RCC_INSTRUMENTATION is enabled in RCC_config.h.
+ *
+ * @return Pointer to the live statistics (cycles of the DWT CYCCNT counter).
+ */
+const RCC_STATS_t *RCC_GetStats(void);
+
+/**
+ * @brief Clears the cycle statistics and starts the DWT cycle counter.
+ * 
+ * Call once before the first instrumented RCC operation.
+ */
+void RCC_ResetStats(void);
+#endif
+
 #endif // RCC_INTERFACE_H
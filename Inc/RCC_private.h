@@ -1,6 +1,7 @@
 #ifndef RCC_PRIVATE_H
 #define RCC_PRIVATE_H
 
+#include "RCC_config.h"
 
 
 /********************* Enumeration for Clock Source Types *********************/
@@ -43,6 +44,197 @@ typedef enum
 	
 }SYS_CLK_t;
 
+/********************* Peripheral Kernels Clockable from PLLR (DCKCFGR) *********************/
+typedef enum
+{
+    PLLR_SAI1 = 20,   // SAI1SRC[1:0]
+    PLLR_SAI2 = 22,   // SAI2SRC[1:0]
+    PLLR_I2S1 = 25,   // I2S1SRC[1:0] (I2S APB1: SPI2 / SPI3)
+    PLLR_I2S2 = 27    // I2S2SRC[1:0] (I2S APB2: SPI1 / SPI4)
+
+}RCC_PLLR_KERNEL_t;
+
+/********************* LSE Oscillator Mode (BDCR LSEMOD / LSEBYP) *********************/
+typedef enum
+{
+    LSE_LOW_DRIVE = 0,   // Crystal, low-power drive (reset mode)
+    LSE_HIGH_DRIVE,      // Crystal, high drive for hard-to-start crystals
+    LSE_BYPASS           // External 32.768 kHz clock on OSC32_IN
+
+}RCC_LSE_MODE_t;
+
+/********************* RTC Clock Source (BDCR RTCSEL) *********************/
+typedef enum
+{
+    RTC_NO_CLK = 0,   // No clock (reset value)
+    RTC_LSE,          // LSE oscillator
+    RTC_LSI,          // LSI oscillator
+    RTC_HSE           // HSE divided by RTCPRE (must give 1 MHz)
+
+}RCC_RTC_SRC_t;
+
+/********************* Reset Cause Flags (RCC_CSR bits 31:25 >> 25) *********************/
+typedef enum
+{
+    RCC_RESET_BOR  = 0x01,   // Brown-out, also set by every power-on
+    RCC_RESET_PIN  = 0x02,   // NRST pin, also set by every other reset source
+    RCC_RESET_POR  = 0x04,   // Power-on / power-down
+    RCC_RESET_SFT  = 0x08,   // Software (NVIC_SystemReset)
+    RCC_RESET_IWDG = 0x10,   // Independent watchdog
+    RCC_RESET_WWDG = 0x20,   // Window watchdog
+    RCC_RESET_LPWR = 0x40    // Illegal Stop / Standby entry
+
+}RCC_RESET_CAUSE_t;
+
+// Causes after which the full power-on self-test should run; any other reset is benign
+#define RCC_RESET_FULL_TEST_MASK   (RCC_RESET_BOR | RCC_RESET_POR | RCC_RESET_IWDG | RCC_RESET_WWDG | RCC_RESET_LPWR)
+
+/********************* Frequency Measurement (timer input capture) *********************/
+typedef enum
+{
+    MEAS_LSI = 0,    // TIM5 CH4 (TIM5_OR TI4_RMP = 01)
+    MEAS_LSE,        // TIM5 CH4 (TIM5_OR TI4_RMP = 10)
+    MEAS_HSE_RTC     // TIM11 CH1 (TIM11_OR TI1_RMP = 10), HSE / RTCPRE
+
+}RCC_MEAS_SRC_t;
+
+typedef struct
+{
+    uint32_t Freq;   // Measured frequency in Hz
+    int32_t  Ppm;    // Deviation from the nominal frequency in parts per million
+
+}RCC_MEAS_RESULT_t;
+
+#define RCC_MEAS_EDGES        8U       // Input capture prescaler: one capture every 8 edges
+#define RCC_MEAS_MAX_PERIODS  4096U    // Captures averaged by one measurement at most
+
+/********************* Peripheral Kernel Clocks (DCKCFGR / DCKCFGR2) *********************/
+typedef enum
+{
+    KERNEL_SAI1 = 0,   // DCKCFGR SAI1SRC
+    KERNEL_SAI2,       // DCKCFGR SAI2SRC
+    KERNEL_I2S_APB2,   // DCKCFGR I2S2SRC (I2S on SPI1 / SPI4)
+    KERNEL_I2S_APB1,   // DCKCFGR I2S1SRC (I2S on SPI2 / SPI3)
+    KERNEL_FMPI2C1,    // DCKCFGR2 FMPI2C1SEL
+    KERNEL_CEC,        // DCKCFGR2 CECSEL
+    KERNEL_CK48,       // DCKCFGR2 CK48MSEL (USB OTG FS, RNG, SDIO)
+    KERNEL_SDIO,       // DCKCFGR2 SDIOSEL
+    KERNEL_SPDIFRX,    // DCKCFGR2 SPDIFRXSEL
+    KERNEL_COUNT
+
+}RCC_KERNEL_t;
+
+typedef enum
+{
+    KSRC_NONE = 0,     // Not a valid selection
+    KSRC_PLLQ,         // Main PLL Q output
+    KSRC_PLLR,         // Main PLL R output
+    KSRC_PLLI2S_P,     // PLLI2S P output
+    KSRC_PLLI2S_Q,     // PLLI2S Q output / PLLI2SDIVQ
+    KSRC_PLLI2S_R,     // PLLI2S R output
+    KSRC_PLLSAI_P,     // PLLSAI P output
+    KSRC_PLLSAI_Q,     // PLLSAI Q output / PLLSAIDIVQ
+    KSRC_PLL_SRC,      // HSI or HSE, whichever feeds the PLLs
+    KSRC_I2S_CKIN,     // External clock on the I2S_CKIN pin (RCC_I2S_CKIN_FREQ)
+    KSRC_SYSCLK,
+    KSRC_PCLK1,
+    KSRC_HSI,
+    KSRC_HSI_488,      // HSI / 488
+    KSRC_LSE,
+    KSRC_CK48          // The 48 MHz clock selected by KERNEL_CK48
+
+}RCC_KERNEL_SRC_t;
+
+// One kernel clock multiplexer: its field and the source behind each field value
+typedef struct
+{
+    uint8_t Dckcfgr2;   // 0: DCKCFGR, 1: DCKCFGR2
+    uint8_t Pos;        // Field position
+    uint8_t Width;      // Field width, 1 or 2 bits
+    uint8_t Src[4];     // RCC_KERNEL_SRC_t for each field value
+
+}RCC_KERNEL_MUX_t;
+
+/********************* Peripheral Group Descriptor *********************/
+/*
+ * Everything one subsystem needs from the RCC, applied by RCC_Group_Enable(). Fields
+ * left 0 are not touched.
+ */
+typedef struct
+{
+    uint32_t AHB1ENR;         // AHB1 clocks to enable
+    uint32_t AHB2ENR;         // AHB2 clocks to enable
+    uint32_t AHB3ENR;         // AHB3 clocks to enable
+    uint32_t APB1ENR;         // APB1 clocks to enable
+    uint32_t APB2ENR;         // APB2 clocks to enable
+    uint32_t DCKCFGR_Mask;    // Kernel clock fields to set in DCKCFGR
+    uint32_t DCKCFGR;         // Their values
+    uint32_t DCKCFGR2_Mask;   // Kernel clock fields to set in DCKCFGR2
+    uint32_t DCKCFGR2;        // Their values
+    uint32_t PLLI2SCFGR;      // PLLI2S word to program and start, 0: PLLI2S not used
+    uint32_t PLLSAICFGR;      // PLLSAI word to program and start, 0: PLLSAI not used
+
+}RCC_GROUP_t;
+
+/********************* Automatic Clock Gating (CKGATENR) *********************/
+/*
+ * Blocks whose clock the hardware may gate while they are idle. In CKGATENR a 0 bit
+ * (reset value) leaves the gating active and a 1 bit keeps the clock always on.
+ */
+typedef enum
+{
+    CKGATE_AHB2APB1 = 0x01,   // AHB to APB1 bridge
+    CKGATE_AHB2APB2 = 0x02,   // AHB to APB2 bridge
+    CKGATE_CM4DBG   = 0x04,   // Cortex-M4 ETM
+    CKGATE_SPARE    = 0x08,   // Spare
+    CKGATE_SRAM     = 0x10,   // SRAM controller
+    CKGATE_FLITF    = 0x20,   // Flash interface
+    CKGATE_RCC      = 0x40    // RCC register interface
+
+}RCC_CKGATE_t;
+
+#define CKGATE_ALL                        0x7FU
+
+// Auto-gating profiles for RCC_CKGATE_SetProfile()
+#define RCC_CKGATE_PROFILE_NONE           0x00U                                          // Every clock always on
+#define RCC_CKGATE_PROFILE_LOW_ACTIVITY   (CKGATE_ALL & ~(CKGATE_SRAM | CKGATE_FLITF))   // Memory paths stay on
+#define RCC_CKGATE_PROFILE_ALL            CKGATE_ALL                                     // Reset state: everything may gate
+
+/********************* Spread Spectrum Profile (SSCGR SPREADSEL) *********************/
+typedef enum
+{
+    SSCG_CENTER = 0,   // Modulation centred on the nominal frequency
+    SSCG_DOWN          // Modulation below the nominal frequency only
+
+}RCC_SSCG_SPREAD_t;
+
+/********************* Microcontroller Clock Outputs (CFGR MCO1 / MCO2) *********************/
+typedef enum
+{
+    MCO1_HSI = 0,    // MCO1 on PA8
+    MCO1_LSE,
+    MCO1_HSE,
+    MCO1_PLL,        // Main PLL P output
+    MCO2_SYSCLK,     // MCO2 on PC9
+    MCO2_PLLI2S,     // PLLI2S R output
+    MCO2_HSE,
+    MCO2_PLL         // Main PLL P output
+
+}RCC_MCO_SRC_t;
+
+/********************* GPIO Output Speed (GPIOx_OSPEEDR) *********************/
+typedef enum
+{
+    GPIO_SPEED_LOW = 0,
+    GPIO_SPEED_MEDIUM,
+    GPIO_SPEED_FAST,
+    GPIO_SPEED_HIGH
+
+}RCC_GPIO_SPEED_t;
+
+/********************* Completion Callback *********************/
+typedef void (*RCC_CALLBACK_t)(void);
+
 /********************* PLL Configuration Structure *********************/
 typedef struct
 {
@@ -51,6 +243,7 @@ typedef struct
     uint8_t  PLL_P;   // PLL division factor for main system clock
     uint16_t PLL_N;   // PLL multiplication factor for VCO
     uint8_t  PLL_M;   // PLL division factor for input clock
+    CLK_t    PLL_Src; // PLL input clock source (HSI or HSE)
 	
 } PLL_CONFIG_t;
 
@@ -145,4 +338,290 @@ typedef enum
 	
 }RCC_APB2_PERIPHERAL_t;
 
+/********************* STM32F446 Clock Tree Limits (RM0390 / DS10693) *********************/
+#define RCC_HSI_FREQ             16000000UL   // HSI nominal frequency
+#define RCC_HSE_MIN_FREQ          4000000UL   // HSE crystal minimum frequency
+#define RCC_HSE_MAX_FREQ         26000000UL   // HSE crystal maximum frequency
+#define RCC_HSE_BYP_MIN_FREQ      1000000UL   // HSE bypass (external clock) minimum frequency
+#define RCC_HSE_BYP_MAX_FREQ     50000000UL   // HSE bypass (external clock) maximum frequency
+#define RCC_VCO_IN_MIN_FREQ       1000000UL   // PLL input after PLLM, minimum
+#define RCC_VCO_IN_MAX_FREQ       2000000UL   // PLL input after PLLM, maximum
+#define RCC_VCO_OUT_MIN_FREQ    100000000UL   // VCO output minimum
+#define RCC_VCO_OUT_MAX_FREQ    432000000UL   // VCO output maximum
+#define RCC_SYSCLK_MAX_FREQ     180000000UL   // SYSCLK / HCLK maximum (over-drive on)
+#define RCC_APB1_MAX_FREQ        45000000UL   // PCLK1 maximum
+#define RCC_APB2_MAX_FREQ        90000000UL   // PCLK2 maximum
+#define RCC_CK48_FREQ            48000000UL   // USB OTG FS / SDIO / RNG clock
+#define RCC_CK48_TOLERANCE         120000UL   // +/-0.25 % required by USB full speed
+#define RCC_LSE_FREQ                32768UL   // LSE crystal frequency
+#define RCC_LSI_FREQ                32000UL   // LSI nominal frequency (17 to 47 kHz over process and temperature)
+#define RCC_HSI_TRIM_STEP_PPM          5000    // Nominal HSI change per HSITRIM step (about 80 kHz at 16 MHz)
+#define RCC_MCO_MAX_DIV                   5U   // MCO1PRE / MCO2PRE: /1 to /5
+#define RCC_SSCG_MAX_MOD_FREQ         10000UL   // Spread-spectrum modulation frequency maximum
+#define RCC_SSCG_MAX_DEPTH              200U    // Spread-spectrum peak depth maximum, 0.01 % units (2 %)
+
+// Maximum I/O toggle frequency per OSPEEDR setting, VDD >= 2.7 V with a 30-50 pF load
+#define RCC_GPIO_LOW_MAX_FREQ     4000000UL
+#define RCC_GPIO_MEDIUM_MAX_FREQ 25000000UL
+#define RCC_GPIO_FAST_MAX_FREQ   50000000UL
+#define RCC_GPIO_HIGH_MAX_FREQ  100000000UL
+
+/********************* Full Clock Configuration Structure *********************/
+typedef struct
+{
+    uint32_t     HSE_Freq;   // HSE frequency in Hz (0 when no HSE is fitted)
+    HSE_t        HSE_Mode;   // HSE crystal or external bypass clock
+    PLL_CONFIG_t PLL;        // Main PLL factors and input source
+    SYS_CLK_t    SysClk;     // System clock source
+    uint16_t     AHB_Div;    // AHB prescaler: 1, 2, 4, 8, 16, 64, 128, 256, 512
+    uint8_t      APB1_Div;   // APB1 prescaler: 1, 2, 4, 8, 16
+    uint8_t      APB2_Div;   // APB2 prescaler: 1, 2, 4, 8, 16
+    uint8_t      Use48MHz;   // Non-zero when USB OTG FS / SDIO / RNG run from PLLQ
+
+} RCC_CLK_CONFIG_t;
+
+/********************* Precomputed Clock Register Image *********************/
+typedef struct
+{
+    uint32_t CR;          // Oscillators to start: HSEON, HSEBYP, PLLON
+    uint32_t PLLCFGR;     // Final PLLCFGR word
+    uint32_t CFGR;        // Final CFGR word, SW selects the system clock
+    uint32_t DCKCFGR;     // Final DCKCFGR word
+    uint32_t DCKCFGR2;    // Final DCKCFGR2 word
+    uint32_t AHB1ENR;     // AHB1 peripheral clock enable mask
+    uint32_t AHB2ENR;     // AHB2 peripheral clock enable mask
+    uint32_t AHB3ENR;     // AHB3 peripheral clock enable mask
+    uint32_t APB1ENR;     // APB1 peripheral clock enable mask
+    uint32_t APB2ENR;     // APB2 peripheral clock enable mask
+    uint32_t FLASH_ACR;   // Flash wait states, prefetch and caches
+    uint32_t OverDrive;   // Non-zero to enable the PWR over-drive (HCLK above 168 MHz)
+
+} RCC_IMAGE_t;
+
+/********************* Clock Tree State Snapshot (RCC_GetClkState) *********************/
+typedef struct
+{
+    uint32_t CR;          // HSION, HSEON, HSEBYP, PLLON, PLLI2SON, PLLSAION
+    uint32_t BDCR;        // LSEON, LSEBYP
+    uint32_t CSR;         // LSION
+    uint32_t AHB1ENR;     // Peripheral clock enables in Run mode
+    uint32_t AHB2ENR;
+    uint32_t AHB3ENR;
+    uint32_t APB1ENR;
+    uint32_t APB2ENR;
+    uint32_t AHB1LPENR;   // Peripheral clock enables in Sleep mode
+    uint32_t AHB2LPENR;
+    uint32_t AHB3LPENR;
+    uint32_t APB1LPENR;
+    uint32_t APB2LPENR;
+    uint32_t SysClk;      // SYSCLK in Hz
+    uint32_t HClk;        // AHB clock in Hz
+    uint32_t PClk1;       // APB1 clock in Hz
+    uint32_t PClk2;       // APB2 clock in Hz
+
+} RCC_CLK_STATE_t;
+
+/********************* Instrumented Operations (RCC_INSTRUMENTATION) *********************/
+typedef enum
+{
+    RCC_OP_SET_CLK_STATUS = 0,
+    RCC_OP_SET_SYSCLK,
+    RCC_OP_HSE_MODE,
+    RCC_OP_PLL_CONFIG,
+    RCC_OP_LOAD_IMAGE,
+    RCC_OP_AHB1_ENABLE,
+    RCC_OP_AHB1_DISABLE,
+    RCC_OP_AHB2_ENABLE,
+    RCC_OP_AHB2_DISABLE,
+    RCC_OP_AHB3_ENABLE,
+    RCC_OP_AHB3_DISABLE,
+    RCC_OP_APB1_ENABLE,
+    RCC_OP_APB1_DISABLE,
+    RCC_OP_APB2_ENABLE,
+    RCC_OP_APB2_DISABLE,
+    RCC_OP_CSS_STATUS,
+    RCC_OP_CSS_EVENT,
+    RCC_OP_PLL_SET_CONFIG,
+    RCC_OP_PLLR_KERNEL,
+    RCC_OP_BACKUP_ACCESS,
+    RCC_OP_BACKUP_RESET,
+    RCC_OP_LSE_MODE,
+    RCC_OP_LSE_START,
+    RCC_OP_LSE_READY,
+    RCC_OP_RTC_CONFIG,
+    RCC_OP_LSI_STATUS,
+    RCC_OP_RESET_CAUSE,
+    RCC_OP_MEASURE,
+    RCC_OP_HSI_TRIM,
+    RCC_OP_MCO_CONFIG,
+    RCC_OP_SSCG_CONFIG,
+    RCC_OP_TIMPRE,
+    RCC_OP_KERNEL_SRC,
+    RCC_OP_CKGATE,
+    RCC_OP_GROUP,
+    RCC_OP_GET_SYSCLK,
+    RCC_OP_PLL_SELECT,
+    RCC_OP_CHECK_CONFIG,
+    RCC_OP_EARLY_INIT,
+    RCC_OP_LSE_IS_READY,
+    RCC_OP_BUS_FREQ,
+    RCC_OP_TIMER_FREQ,
+    RCC_OP_CLK_STATE,
+    RCC_OP_KERNEL_QUERY,
+    RCC_OP_COUNT
+
+}RCC_OP_t;
+
+/********************* Instrumented Ready-Waits (RCC_INSTRUMENTATION) *********************/
+typedef enum
+{
+    RCC_WAIT_OSC_READY = 0,   // HSI / PLLI2S / PLLSAI ready flag
+    RCC_WAIT_HSE_READY,       // HSE start-up
+    RCC_WAIT_PLL_UNLOCK,      // PLL stop before reconfiguration
+    RCC_WAIT_PLL_LOCK,        // PLL lock
+    RCC_WAIT_OVERDRIVE,       // PWR over-drive ready and switch
+    RCC_WAIT_FLASH_LATENCY,   // Flash wait states taken into account
+    RCC_WAIT_SYSCLK_SWITCH,   // SWS matching SW
+    RCC_WAIT_CAPTURE,         // Timer input capture during a frequency measurement
+    RCC_WAIT_COUNT
+
+}RCC_WAIT_t;
+
+/********************* Cycle Statistics *********************/
+typedef struct
+{
+    uint32_t Count;   // Number of samples
+    uint32_t Last;    // Cycles of the latest sample
+    uint32_t Min;     // Fewest cycles seen
+    uint32_t Max;     // Most cycles seen
+
+} RCC_CYCLE_STAT_t;
+
+typedef struct
+{
+    RCC_CYCLE_STAT_t Op[RCC_OP_COUNT];       // Entry to exit of each public function
+    RCC_CYCLE_STAT_t Wait[RCC_WAIT_COUNT];   // Duration of each ready-wait
+
+} RCC_STATS_t;
+
+/********************* Clock Event Trace (RCC_TRACE) *********************/
+typedef struct
+{
+    uint32_t Seq;      // Claim index + 1, written last: a record is complete when Seq matches its slot
+    uint32_t Cycles;   // DWT CYCCNT timestamp
+    uint8_t  Op;       // RCC_OP_t that changed the register
+    uint8_t  Arg;      // Clock, source or peripheral argument of the operation
+    uint16_t Reg;      // Byte offset of the register in RCC_RegDef_t
+    uint32_t Old;      // Register value before the change
+    uint32_t New;      // Register value written
+
+} RCC_TRACE_RECORD_t;
+
+typedef struct
+{
+    volatile uint32_t  Head;       // Number of records claimed since reset
+    RCC_TRACE_RECORD_t Rec[RCC_TRACE_DEPTH];
+
+} RCC_TRACE_t;
+
+/********************* Clock Configuration Violation Flags *********************/
+typedef enum
+{
+    RCC_CFG_ERR_NULL_PTR    = (1 << 0),   // No configuration given
+    RCC_CFG_ERR_SYSCLK_SRC  = (1 << 1),   // System clock source is not a SYS_CLK_t value
+    RCC_CFG_ERR_PLL_SRC     = (1 << 2),   // PLL source is neither HSI nor HSE
+    RCC_CFG_ERR_HSE_FREQ    = (1 << 3),   // HSE used but outside the crystal / bypass range
+    RCC_CFG_ERR_PLLM        = (1 << 4),   // PLLM outside 2..63
+    RCC_CFG_ERR_VCO_IN      = (1 << 5),   // VCO input outside 1..2 MHz
+    RCC_CFG_ERR_PLLN        = (1 << 6),   // PLLN outside 50..432
+    RCC_CFG_ERR_VCO_OUT     = (1 << 7),   // VCO output outside 100..432 MHz
+    RCC_CFG_ERR_PLLP        = (1 << 8),   // PLLP not one of 2, 4, 6, 8
+    RCC_CFG_ERR_PLLQ        = (1 << 9),   // PLLQ outside 2..15
+    RCC_CFG_ERR_PLLR        = (1 << 10),  // PLLR outside 2..7
+    RCC_CFG_ERR_SYSCLK_MAX  = (1 << 11),  // SYSCLK above 180 MHz
+    RCC_CFG_ERR_AHB_DIV     = (1 << 12),  // AHB prescaler not supported
+    RCC_CFG_ERR_APB1_DIV    = (1 << 13),  // APB1 prescaler not supported
+    RCC_CFG_ERR_APB2_DIV    = (1 << 14),  // APB2 prescaler not supported
+    RCC_CFG_ERR_APB1_MAX    = (1 << 15),  // PCLK1 above 45 MHz
+    RCC_CFG_ERR_APB2_MAX    = (1 << 16),  // PCLK2 above 90 MHz
+    RCC_CFG_ERR_CK48_FREQ   = (1 << 17),  // PLLQ output not within 48 MHz +/-0.25 %
+    RCC_CFG_ERR_CK48_SRC    = (1 << 18)   // 48 MHz clock derived from HSI (1 % accuracy)
+
+}RCC_CFG_ERR_t;
+
+/********************* Clock Configuration Check Macros *********************/
+/*
+ * The macros below only use integer constant expressions, so the same check can
+ * run inside _Static_assert() for fixed board configurations and at runtime
+ * through RCC_CheckClkConfig(). Example:
+ *
+ *   _Static_assert(RCC_CFG_CHECK(8000000UL, NOT_BYPASSED, HSE, 4, 180, 2, 8, 2,
+ *                                SYSPLLP, 1, 4, 2, 0) == 0, "Invalid clock tree");
+ */
+#define RCC_PLL_IN_FREQ(HSE_FREQ, SRC)          (((SRC) == HSE) ? (unsigned long long)(HSE_FREQ) : (unsigned long long)RCC_HSI_FREQ)
+#define RCC_VCO_IN_FREQ(HSE_FREQ, SRC, M)       (((M) != 0) ? RCC_PLL_IN_FREQ(HSE_FREQ, SRC) / (M) : 0ULL)
+#define RCC_VCO_OUT_FREQ(HSE_FREQ, SRC, M, N)   (((M) != 0) ? RCC_PLL_IN_FREQ(HSE_FREQ, SRC) * (N) / (M) : 0ULL)
+#define RCC_PLL_DIV_FREQ(VCO, DIV)              (((DIV) != 0) ? (VCO) / (DIV) : 0ULL)
+
+#define RCC_SYSCLK_CFG_FREQ(HSE_FREQ, SRC, M, N, P, R, SYS)                                      \
+    (((SYS) == SYSHSI)  ? (unsigned long long)RCC_HSI_FREQ :                                     \
+     ((SYS) == SYSHSE)  ? (unsigned long long)(HSE_FREQ) :                                       \
+     ((SYS) == SYSPLLP) ? RCC_PLL_DIV_FREQ(RCC_VCO_OUT_FREQ(HSE_FREQ, SRC, M, N), P) :           \
+                          RCC_PLL_DIV_FREQ(RCC_VCO_OUT_FREQ(HSE_FREQ, SRC, M, N), R))
+
+#define RCC_IS_AHB_DIV(D)     ((D) == 1 || (D) == 2 || (D) == 4 || (D) == 8 || (D) == 16 || \
+                               (D) == 64 || (D) == 128 || (D) == 256 || (D) == 512)
+#define RCC_IS_APB_DIV(D)     ((D) == 1 || (D) == 2 || (D) == 4 || (D) == 8 || (D) == 16)
+#define RCC_IS_PLLP_DIV(P)    ((P) == 2 || (P) == 4 || (P) == 6 || (P) == 8)
+
+#define RCC_CFG_PLL_USED(SYS, USE48)   ((SYS) == SYSPLLP || (SYS) == SYSPLLR || (USE48))
+#define RCC_CFG_HSE_USED(SRC, SYS, USE48) \
+    ((SYS) == SYSHSE || (RCC_CFG_PLL_USED(SYS, USE48) && (SRC) == HSE))
+
+#define RCC_CFG_CHECK_HSE(HSE_FREQ, HSE_MODE, SRC, SYS, USE48)                                   \
+    ((RCC_CFG_HSE_USED(SRC, SYS, USE48) &&                                                       \
+      (((HSE_MODE) == BYPASSED) ?                                                                \
+           ((HSE_FREQ) < RCC_HSE_BYP_MIN_FREQ || (HSE_FREQ) > RCC_HSE_BYP_MAX_FREQ) :            \
+           ((HSE_FREQ) < RCC_HSE_MIN_FREQ || (HSE_FREQ) > RCC_HSE_MAX_FREQ))) ? RCC_CFG_ERR_HSE_FREQ : 0)
+
+#define RCC_CFG_CHECK_PLL(HSE_FREQ, SRC, M, N, P, Q, R, SYS, USE48)                              \
+    (!RCC_CFG_PLL_USED(SYS, USE48) ? 0 :                                                         \
+     ((((SRC) != HSI && (SRC) != HSE) ? RCC_CFG_ERR_PLL_SRC : 0) |                               \
+      (((M) < 2 || (M) > 63) ? RCC_CFG_ERR_PLLM : 0) |                                           \
+      ((RCC_VCO_IN_FREQ(HSE_FREQ, SRC, M) < RCC_VCO_IN_MIN_FREQ ||                                \
+        RCC_VCO_IN_FREQ(HSE_FREQ, SRC, M) > RCC_VCO_IN_MAX_FREQ) ? RCC_CFG_ERR_VCO_IN : 0) |      \
+      (((N) < 50 || (N) > 432) ? RCC_CFG_ERR_PLLN : 0) |                                         \
+      ((RCC_VCO_OUT_FREQ(HSE_FREQ, SRC, M, N) < RCC_VCO_OUT_MIN_FREQ ||                           \
+        RCC_VCO_OUT_FREQ(HSE_FREQ, SRC, M, N) > RCC_VCO_OUT_MAX_FREQ) ? RCC_CFG_ERR_VCO_OUT : 0) | \
+      (((SYS) == SYSPLLP && !RCC_IS_PLLP_DIV(P)) ? RCC_CFG_ERR_PLLP : 0) |                       \
+      (((USE48) && ((Q) < 2 || (Q) > 15)) ? RCC_CFG_ERR_PLLQ : 0) |                              \
+      (((SYS) == SYSPLLR && ((R) < 2 || (R) > 7)) ? RCC_CFG_ERR_PLLR : 0)))
+
+#define RCC_CFG_CHECK_CK48(HSE_FREQ, SRC, M, N, Q, USE48)                                        \
+    (!(USE48) ? 0 :                                                                              \
+     (((SRC) == HSI ? RCC_CFG_ERR_CK48_SRC : 0) |                                                \
+      ((RCC_PLL_DIV_FREQ(RCC_VCO_OUT_FREQ(HSE_FREQ, SRC, M, N), Q) + RCC_CK48_TOLERANCE < RCC_CK48_FREQ || \
+        RCC_PLL_DIV_FREQ(RCC_VCO_OUT_FREQ(HSE_FREQ, SRC, M, N), Q) > RCC_CK48_FREQ + RCC_CK48_TOLERANCE) ? \
+           RCC_CFG_ERR_CK48_FREQ : 0)))
+
+#define RCC_CFG_CHECK_BUS(HSE_FREQ, SRC, M, N, P, R, SYS, AHB, APB1, APB2)                       \
+    ((!RCC_IS_AHB_DIV(AHB) ? RCC_CFG_ERR_AHB_DIV : 0) |                                          \
+     (!RCC_IS_APB_DIV(APB1) ? RCC_CFG_ERR_APB1_DIV : 0) |                                        \
+     (!RCC_IS_APB_DIV(APB2) ? RCC_CFG_ERR_APB2_DIV : 0) |                                        \
+     ((RCC_SYSCLK_CFG_FREQ(HSE_FREQ, SRC, M, N, P, R, SYS) > RCC_SYSCLK_MAX_FREQ) ? RCC_CFG_ERR_SYSCLK_MAX : 0) | \
+     ((RCC_IS_AHB_DIV(AHB) && RCC_IS_APB_DIV(APB1) &&                                            \
+       RCC_SYSCLK_CFG_FREQ(HSE_FREQ, SRC, M, N, P, R, SYS) / (AHB) / (APB1) > RCC_APB1_MAX_FREQ) ? \
+          RCC_CFG_ERR_APB1_MAX : 0) |                                                            \
+     ((RCC_IS_AHB_DIV(AHB) && RCC_IS_APB_DIV(APB2) &&                                            \
+       RCC_SYSCLK_CFG_FREQ(HSE_FREQ, SRC, M, N, P, R, SYS) / (AHB) / (APB2) > RCC_APB2_MAX_FREQ) ? \
+          RCC_CFG_ERR_APB2_MAX : 0))
+
+/* Returns the RCC_CFG_ERR_t flags violated by a clock configuration, 0 when it is legal */
+#define RCC_CFG_CHECK(HSE_FREQ, HSE_MODE, SRC, M, N, P, Q, R, SYS, AHB, APB1, APB2, USE48)       \
+    (((unsigned)(SYS) > SYSPLLR) ? RCC_CFG_ERR_SYSCLK_SRC :                             \
+      (RCC_CFG_CHECK_HSE(HSE_FREQ, HSE_MODE, SRC, SYS, USE48) |                                  \
+       RCC_CFG_CHECK_PLL(HSE_FREQ, SRC, M, N, P, Q, R, SYS, USE48) |                             \
+       RCC_CFG_CHECK_CK48(HSE_FREQ, SRC, M, N, Q, USE48) |                                       \
+       RCC_CFG_CHECK_BUS(HSE_FREQ, SRC, M, N, P, R, SYS, AHB, APB1, APB2)))
+
 #endif // RCC_PRIVATE_H
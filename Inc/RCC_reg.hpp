@@ -0,0 +1,233 @@
+#ifndef RCC_REG_HPP
+#define RCC_REG_HPP
+
+/*
+ * Type-safe RCC register access for C++17 code (header only).
+ *
+ * Registers are named by a pointer to their RCC_RegDef_t member and fields by
+ * Register + position + width, so the magic shifts of the C driver become named,
+ * width-checked constants:
+ *
+ *     rcc::modify(rcc::pllcfgr::M::value(4), rcc::pllcfgr::N::value(168),
+ *                 rcc::pllcfgr::SRC::value(1));        // one read, one store
+ *     rcc::enable<GPIOAEN, GPIOBEN, DMA1EN>();         // one read, one store on AHB1ENR
+ *     rcc::enable<GPIOAEN, USART2EN>();                // compile error: two buses
+ *
+ * All field values of one call are folded into a single mask/value pair at compile
+ * time (or with plain ALU operations for run-time values), so the generated code is
+ * the same read-modify-write the C driver spells out by hand. Mixing fields of
+ * different registers in one call, constant values wider than their field and IDs
+ * that are not RCC peripheral enumerators are rejected by static_assert.
+ *
+ * Built with -DRCC_HOST_SIM the accesses go through the host simulator, like
+ * Src/RCC_prog.c.
+ */
+
+#include <cstdint>
+#include <type_traits>
+#include "RCC_private.h"
+#include "STM32F446xx.h"
+
+#ifdef RCC_HOST_SIM
+#include "RCC_sim.h"
+#endif
+
+namespace rcc {
+
+/********************* Registers *********************/
+using Member = volatile uint32_t RCC_RegDef_t::*;
+
+template <Member M>
+struct Reg
+{
+    static volatile uint32_t &ref() {
+#ifdef RCC_HOST_SIM
+        return RCCSim_Regs.Rcc.*M;
+#else
+        return reinterpret_cast<RCC_RegDef_t *>(RCC_BASE_ADDRESS)->*M;
+#endif
+    }
+
+    static uint32_t read() {
+#ifdef RCC_HOST_SIM
+        return RCCSim_Read(&ref());
+#else
+        return ref();
+#endif
+    }
+
+    static void write(uint32_t Value) {
+#ifdef RCC_HOST_SIM
+        RCCSim_Write(&ref(), Value);
+#else
+        ref() = Value;
+#endif
+    }
+};
+
+/********************* Fields *********************/
+// A value to be stored into one or more fields of register R
+template <Member R>
+struct FieldValue
+{
+    uint32_t Mask;
+    uint32_t Bits;
+};
+
+template <Member R, unsigned Pos, unsigned Width>
+struct Field
+{
+    static_assert(Width >= 1 && Pos + Width <= 32, "field outside the 32-bit register");
+
+    static constexpr Member   Register = R;
+    static constexpr uint32_t Mask = ((Width == 32) ? 0xFFFFFFFFUL : ((1UL << Width) - 1UL)) << Pos;
+
+    // Run-time value, truncated to the field width
+    static constexpr FieldValue<R> value(uint32_t Value) {
+        return FieldValue<R>{Mask, (Value << Pos) & Mask};
+    }
+
+    // Compile-time value, rejected when it does not fit the field
+    template <uint32_t Value>
+    static constexpr FieldValue<R> value() {
+        static_assert(Width == 32 || Value < (1UL << Width), "value does not fit the field");
+        return FieldValue<R>{Mask, Value << Pos};
+    }
+
+    static constexpr FieldValue<R> set() {
+        return FieldValue<R>{Mask, Mask};
+    }
+
+    static constexpr FieldValue<R> clear() {
+        return FieldValue<R>{Mask, 0};
+    }
+
+    static uint32_t read() {
+        return (Reg<R>::read() & Mask) >> Pos;
+    }
+};
+
+/**
+ * @brief Writes several fields of one register with a single read and a single store.
+ */
+template <Member R, typename... Rest>
+inline void modify(FieldValue<R> First, Rest... Others) {
+    static_assert((std::is_same_v<Rest, FieldValue<R>> && ...), "all fields of one modify() must belong to the same register");
+    const uint32_t Mask = (First.Mask | ... | Others.Mask);
+    const uint32_t Bits = (First.Bits | ... | Others.Bits);
+
+    Reg<R>::write((Reg<R>::read() & ~Mask) | Bits);
+}
+
+/**
+ * @brief Stores a whole register in one write; fields not given are written as 0.
+ */
+template <Member R, typename... Rest>
+inline void write(FieldValue<R> First, Rest... Others) {
+    static_assert((std::is_same_v<Rest, FieldValue<R>> && ...), "all fields of one write() must belong to the same register");
+
+    Reg<R>::write(First.Bits | (Others.Bits | ... | 0UL));
+}
+
+/********************* Field Descriptors (RM0390 section 6.3) *********************/
+namespace cr {
+    using HSION    = Field<&RCC_RegDef_t::CR, 0, 1>;
+    using HSIRDY   = Field<&RCC_RegDef_t::CR, 1, 1>;
+    using HSITRIM  = Field<&RCC_RegDef_t::CR, 3, 5>;
+    using HSICAL   = Field<&RCC_RegDef_t::CR, 8, 8>;
+    using HSEON    = Field<&RCC_RegDef_t::CR, 16, 1>;
+    using HSERDY   = Field<&RCC_RegDef_t::CR, 17, 1>;
+    using HSEBYP   = Field<&RCC_RegDef_t::CR, 18, 1>;
+    using CSSON    = Field<&RCC_RegDef_t::CR, 19, 1>;
+    using PLLON    = Field<&RCC_RegDef_t::CR, 24, 1>;
+    using PLLRDY   = Field<&RCC_RegDef_t::CR, 25, 1>;
+    using PLLI2SON = Field<&RCC_RegDef_t::CR, 26, 1>;
+    using PLLSAION = Field<&RCC_RegDef_t::CR, 28, 1>;
+}
+
+namespace pllcfgr {
+    using M   = Field<&RCC_RegDef_t::PLLCFGR, 0, 6>;
+    using N   = Field<&RCC_RegDef_t::PLLCFGR, 6, 9>;
+    using P   = Field<&RCC_RegDef_t::PLLCFGR, 16, 2>;   // 0: /2, 1: /4, 2: /6, 3: /8
+    using SRC = Field<&RCC_RegDef_t::PLLCFGR, 22, 1>;   // 0: HSI, 1: HSE
+    using Q   = Field<&RCC_RegDef_t::PLLCFGR, 24, 4>;
+    using R   = Field<&RCC_RegDef_t::PLLCFGR, 28, 3>;
+}
+
+namespace cfgr {
+    using SW      = Field<&RCC_RegDef_t::CFGR, 0, 2>;
+    using SWS     = Field<&RCC_RegDef_t::CFGR, 2, 2>;
+    using HPRE    = Field<&RCC_RegDef_t::CFGR, 4, 4>;
+    using PPRE1   = Field<&RCC_RegDef_t::CFGR, 10, 3>;
+    using PPRE2   = Field<&RCC_RegDef_t::CFGR, 13, 3>;
+    using RTCPRE  = Field<&RCC_RegDef_t::CFGR, 16, 5>;
+    using MCO1    = Field<&RCC_RegDef_t::CFGR, 21, 2>;
+    using MCO1PRE = Field<&RCC_RegDef_t::CFGR, 24, 3>;
+    using MCO2PRE = Field<&RCC_RegDef_t::CFGR, 27, 3>;
+    using MCO2    = Field<&RCC_RegDef_t::CFGR, 30, 2>;
+}
+
+namespace cir {
+    using CSSF = Field<&RCC_RegDef_t::CIR, 7, 1>;
+    using CSSC = Field<&RCC_RegDef_t::CIR, 23, 1>;
+}
+
+/********************* Peripheral Clock Enables *********************/
+// Maps each peripheral enumeration of RCC_private.h to its enable register
+template <typename E>
+struct Bus
+{
+    static_assert(!std::is_same_v<E, E>, "not an RCC peripheral enumerator (RCC_AHB1/AHB2/AHB3/APB1/APB2_PERIPHERAL_t)");
+};
+
+template <> struct Bus<RCC_AHB1_PERIPHERAL_t> { static constexpr Member ENR = &RCC_RegDef_t::AHB1ENR; };
+template <> struct Bus<RCC_AHB2_PERIPHERAL_t> { static constexpr Member ENR = &RCC_RegDef_t::AHB2ENR; };
+template <> struct Bus<RCC_AHB3_PERIPHERAL_t> { static constexpr Member ENR = &RCC_RegDef_t::AHB3ENR; };
+template <> struct Bus<RCC_APB1_PERIPHERAL_t> { static constexpr Member ENR = &RCC_RegDef_t::APB1ENR; };
+template <> struct Bus<RCC_APB2_PERIPHERAL_t> { static constexpr Member ENR = &RCC_RegDef_t::APB2ENR; };
+
+template <auto First, auto... Others>
+struct SameBus
+{
+    using Type = decltype(First);
+
+    static_assert((std::is_same_v<Type, decltype(Others)> && ...), "peripherals of one enable()/disable() must sit on the same bus");
+    static_assert(((static_cast<unsigned>(First) < 32) && ... && (static_cast<unsigned>(Others) < 32)), "peripheral bit out of range");
+
+    static constexpr Member   ENR = Bus<Type>::ENR;
+    static constexpr uint32_t Mask = (1UL << static_cast<unsigned>(First)) | ((1UL << static_cast<unsigned>(Others)) | ... | 0UL);
+};
+
+/**
+ * @brief Enables the clocks of one or more peripherals of the same bus in one store.
+ */
+template <auto... Periphs>
+inline void enable() {
+    using B = SameBus<Periphs...>;
+
+    Reg<B::ENR>::write(Reg<B::ENR>::read() | B::Mask);
+}
+
+/**
+ * @brief Disables the clocks of one or more peripherals of the same bus in one store.
+ */
+template <auto... Periphs>
+inline void disable() {
+    using B = SameBus<Periphs...>;
+
+    Reg<B::ENR>::write(Reg<B::ENR>::read() & ~B::Mask);
+}
+
+/**
+ * @brief Tells whether the clock of a peripheral is enabled.
+ */
+template <auto Periph>
+inline bool enabled() {
+    using B = SameBus<Periph>;
+
+    return (Reg<B::ENR>::read() & B::Mask) != 0;
+}
+
+} // namespace rcc
+
+#endif // RCC_REG_HPP
@@ -6,6 +6,13 @@
 #define SRAM_BASE_ADDRESS			 0x20000000UL
 #define ROM_BASE_ADDRESS			 0x1FFF0000UL
 
+/******************* Cortex-M4 Core Peripheral Base Addresses *******************/
+#define DWT_BASE_ADDRESS			 0xE0001000UL
+#define COREDEBUG_BASE_ADDRESS		 0xE000EDF0UL
+#define SYSTICK_BASE_ADDRESS		 0xE000E010UL
+#define NVIC_BASE_ADDRESS			 0xE000E100UL
+#define SCB_BASE_ADDRESS			 0xE000ED00UL
+
 /******************* AHB1 Preipheral Base Addresses *******************/
 #define GPIOA_BASE_ADDRESS			 0x40020000U
 #define GPIOB_BASE_ADDRESS			 0x40020400U
@@ -17,15 +24,78 @@
 #define GPIOH_BASE_ADDRESS			 0x40021C00U
 	 
 #define RCC_BASE_ADDRESS 			 0x40023800U
+#define FLASH_R_BASE_ADDRESS		 0x40023C00U
 
 /******************* AHB2 Preipheral Base Addresses *******************/
 
 /******************* AHB3 Preipheral Base Addresses *******************/
 
 /******************* APB1 Preipheral Base Addresses *******************/
+#define TIM5_BASE_ADDRESS			 0x40000C00U
+#define RTC_BASE_ADDRESS			 0x40002800U
+#define PWR_BASE_ADDRESS			 0x40007000U
 
 /******************* APB2 Preipheral Base Addresses *******************/
+#define EXTI_BASE_ADDRESS			 0x40013C00U
+#define TIM11_BASE_ADDRESS			 0x40014800U
+
+
+/******************* DWT Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t CTRL;				/*!<DWT Control register,                                                              */
+	volatile uint32_t CYCCNT;			/*!<DWT Cycle count register,                                                          */
+
+}DWT_RegDef_t;
+
+/******************* CoreDebug Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t DHCSR;			/*!<Debug Halting Control and Status register,                                         */
+	volatile uint32_t DCRSR;			/*!<Debug Core Register Selector register,                                             */
+	volatile uint32_t DCRDR;			/*!<Debug Core Register Data register,                                                 */
+	volatile uint32_t DEMCR;			/*!<Debug Exception and Monitor Control register,                                      */
+
+}CoreDebug_RegDef_t;
+
+/******************* SysTick Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t CTRL;				/*!<SysTick Control and Status register,                                               */
+	volatile uint32_t LOAD;				/*!<SysTick Reload Value register,                                                     */
+	volatile uint32_t VAL;				/*!<SysTick Current Value register,                                                    */
+	volatile uint32_t CALIB;			/*!<SysTick Calibration Value register,                                                */
+
+}SysTick_RegDef_t;
+
+/******************* NVIC Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t ISER[8];			/*!<NVIC Interrupt set-enable registers,                                               */
+	uint32_t          RESERVED0[24];
+	volatile uint32_t ICER[8];			/*!<NVIC Interrupt clear-enable registers,                                             */
+	uint32_t          RESERVED1[24];
+	volatile uint32_t ISPR[8];			/*!<NVIC Interrupt set-pending registers,                                              */
+	uint32_t          RESERVED2[24];
+	volatile uint32_t ICPR[8];			/*!<NVIC Interrupt clear-pending registers,                                            */
+
+}NVIC_RegDef_t;
+
+/******************* SCB Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t CPUID;			/*!<SCB CPUID base register,                                                           */
+	volatile uint32_t ICSR;				/*!<SCB Interrupt control and state register,                                          */
+	volatile uint32_t VTOR;				/*!<SCB Vector table offset register,                                                  */
+	volatile uint32_t AIRCR;			/*!<SCB Application interrupt and reset control register,                              */
+	volatile uint32_t SCR;				/*!<SCB System control register,                                                       */
 
+}SCB_RegDef_t;
 
 /******************* GPIO Register Definition Structure *******************/
 
@@ -45,14 +115,14 @@ typedef struct {
 
 /******************* GPIO Preipheral Base Addresses *******************/
 
-#define GPIOA                  ((GPIO_RegDef_t*)GPIOA_BASE_Address)
-#define GPIOB                  ((GPIO_RegDef_t*)GPIOB_BASE_Address)
-#define GPIOC                  ((GPIO_RegDef_t*)GPIOC_BASE_Address)
-#define GPIOD                  ((GPIO_RegDef_t*)GPIOD_BASE_Address)
-#define GPIOE                  ((GPIO_RegDef_t*)GPIOE_BASE_Address)
-#define GPIOF                  ((GPIO_RegDef_t*)GPIOF_BASE_Address)
-#define GPIOG                  ((GPIO_RegDef_t*)GPIOG_BASE_Address)
-#define GPIOH                  ((GPIO_RegDef_t*)GPIOH_BASE_Address)
+#define GPIOA                  ((GPIO_RegDef_t*)GPIOA_BASE_ADDRESS)
+#define GPIOB                  ((GPIO_RegDef_t*)GPIOB_BASE_ADDRESS)
+#define GPIOC                  ((GPIO_RegDef_t*)GPIOC_BASE_ADDRESS)
+#define GPIOD                  ((GPIO_RegDef_t*)GPIOD_BASE_ADDRESS)
+#define GPIOE                  ((GPIO_RegDef_t*)GPIOE_BASE_ADDRESS)
+#define GPIOF                  ((GPIO_RegDef_t*)GPIOF_BASE_ADDRESS)
+#define GPIOG                  ((GPIO_RegDef_t*)GPIOG_BASE_ADDRESS)
+#define GPIOH                  ((GPIO_RegDef_t*)GPIOH_BASE_ADDRESS)
 
 /******************* RCC Register Definition Structure *******************/
 
@@ -96,4 +166,93 @@ typedef struct
 	
 }RCC_RegDef_t;
 
+/******************* FLASH Interface Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t ACR;				/*!<FLASH Access control register,                                                     */
+	volatile uint32_t KEYR;				/*!<FLASH Key register,                                                                */
+	volatile uint32_t OPTKEYR;			/*!<FLASH Option key register,                                                         */
+	volatile uint32_t SR;				/*!<FLASH Status register,                                                             */
+	volatile uint32_t CR;				/*!<FLASH Control register,                                                            */
+	volatile uint32_t OPTCR;			/*!<FLASH Option control register,                                                     */
+
+}FLASH_RegDef_t;
+
+/******************* PWR Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t CR;				/*!<PWR Power control register,                                                        */
+	volatile uint32_t CSR;				/*!<PWR Power control/status register,                                                 */
+
+}PWR_RegDef_t;
+
+/******************* TIM Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t CR1;				/*!<TIM control register 1,                                                            */
+	volatile uint32_t CR2;				/*!<TIM control register 2,                                                            */
+	volatile uint32_t SMCR;				/*!<TIM slave mode control register,                                                   */
+	volatile uint32_t DIER;				/*!<TIM DMA/interrupt enable register,                                                 */
+	volatile uint32_t SR;				/*!<TIM status register,                                                               */
+	volatile uint32_t EGR;				/*!<TIM event generation register,                                                     */
+	volatile uint32_t CCMR1;			/*!<TIM capture/compare mode register 1,                                               */
+	volatile uint32_t CCMR2;			/*!<TIM capture/compare mode register 2,                                               */
+	volatile uint32_t CCER;				/*!<TIM capture/compare enable register,                                               */
+	volatile uint32_t CNT;				/*!<TIM counter,                                                                       */
+	volatile uint32_t PSC;				/*!<TIM prescaler,                                                                     */
+	volatile uint32_t ARR;				/*!<TIM auto-reload register,                                                          */
+	volatile uint32_t RCR;				/*!<TIM repetition counter register (TIM1/TIM8 only),                                  */
+	volatile uint32_t CCR1;				/*!<TIM capture/compare register 1,                                                    */
+	volatile uint32_t CCR2;				/*!<TIM capture/compare register 2,                                                    */
+	volatile uint32_t CCR3;				/*!<TIM capture/compare register 3,                                                    */
+	volatile uint32_t CCR4;				/*!<TIM capture/compare register 4,                                                    */
+	volatile uint32_t BDTR;				/*!<TIM break and dead-time register (TIM1/TIM8 only),                                 */
+	volatile uint32_t DCR;				/*!<TIM DMA control register,                                                          */
+	volatile uint32_t DMAR;				/*!<TIM DMA address for full transfer,                                                 */
+	volatile uint32_t OR;				/*!<TIM option register (TIM2, TIM5, TIM11),                                           */
+
+}TIM_RegDef_t;
+
+/******************* RTC Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t TR;				/*!<RTC time register,                                                                 */
+	volatile uint32_t DR;				/*!<RTC date register,                                                                 */
+	volatile uint32_t CR;				/*!<RTC control register,                                                              */
+	volatile uint32_t ISR;				/*!<RTC initialization and status register,                                            */
+	volatile uint32_t PRER;				/*!<RTC prescaler register,                                                            */
+	volatile uint32_t WUTR;				/*!<RTC wakeup timer register,                                                         */
+	volatile uint32_t CALIBR;			/*!<RTC calibration register,                                                          */
+	volatile uint32_t ALRMAR;			/*!<RTC alarm A register,                                                              */
+	volatile uint32_t ALRMBR;			/*!<RTC alarm B register,                                                              */
+	volatile uint32_t WPR;				/*!<RTC write protection register,                                                     */
+	volatile uint32_t SSR;				/*!<RTC sub second register,                                                           */
+	volatile uint32_t SHIFTR;			/*!<RTC shift control register,                                                        */
+	volatile uint32_t TSTR;				/*!<RTC time stamp time register,                                                      */
+	volatile uint32_t TSDR;				/*!<RTC time stamp date register,                                                      */
+	volatile uint32_t TSSSR;			/*!<RTC time-stamp sub second register,                                                */
+	volatile uint32_t CALR;				/*!<RTC calibration register,                                                          */
+	volatile uint32_t TAFCR;			/*!<RTC tamper and alternate function configuration register,                          */
+	volatile uint32_t ALRMASSR;			/*!<RTC alarm A sub second register,                                                   */
+	volatile uint32_t ALRMBSSR;			/*!<RTC alarm B sub second register,                                                   */
+
+}RTC_RegDef_t;
+
+/******************* EXTI Register Definition Structure *******************/
+
+typedef struct
+{
+	volatile uint32_t IMR;				/*!<EXTI Interrupt mask register,                                                      */
+	volatile uint32_t EMR;				/*!<EXTI Event mask register,                                                          */
+	volatile uint32_t RTSR;				/*!<EXTI Rising trigger selection register,                                            */
+	volatile uint32_t FTSR;				/*!<EXTI Falling trigger selection register,                                           */
+	volatile uint32_t SWIER;			/*!<EXTI Software interrupt event register,                                            */
+	volatile uint32_t PR;				/*!<EXTI Pending register,                                                             */
+
+}EXTI_RegDef_t;
+
 #endif 
\ No newline at end of file
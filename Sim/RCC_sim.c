@@ -0,0 +1,461 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "RCC_sim.h"
+
+RCCSIM_REGS_t RCCSim_Regs;
+RCCSIM_OSC_t  RCCSim_Osc;
+
+static RCCSIM_COUNTERS_t Counters;
+
+typedef struct
+{
+    RCCSIM_FAULT_t Fault;
+    uint32_t       Reads;    // Reads of Fault.Reg since arming (FLIP) or since its last write (DELAY)
+    uint32_t       Accesses; // Counted accesses since arming (CSS)
+    uint8_t        Armed;
+
+}RCCSIM_FAULT_SLOT_t;
+
+static RCCSIM_FAULT_SLOT_t Faults[RCCSIM_MAX_FAULTS];
+
+static FILE    *TraceFile;
+static uint32_t TraceSeq;
+
+static uint64_t CapturePhase[2];  // Timer ticks owed to the next capture, in 1/source-Hz units
+
+#define REG_IS(PTR, FIELD)    ((PTR) == &RCCSim_Regs.FIELD)
+#define BIT(N)                (1UL << (N))
+
+/********************* Writable Bit Masks *********************/
+#define CR_WRITABLE           (BIT(0) | (0x1FUL << 3) | BIT(16) | BIT(18) | BIT(19) | BIT(24) | BIT(26) | BIT(28))
+#define CFGR_WRITABLE         (~(0x3UL << 2))
+#define CIR_ENABLES           (0x7FUL << 8)
+#define BDCR_WRITABLE         (BIT(0) | BIT(2) | BIT(3) | (0x3UL << 8) | BIT(15) | BIT(16))
+#define CSR_WRITABLE          (BIT(0))
+#define CSR_RESET_FLAGS       (0x7FUL << 25)
+
+/**
+ * @brief Tells whether a register belongs to the bus-counted peripherals.
+ */
+static int IsCounted(const volatile uint32_t *Reg) {
+    const volatile uint8_t *Addr = (const volatile uint8_t *)Reg;
+    const volatile uint8_t *Dwt = (const volatile uint8_t *)&RCCSim_Regs.Dwt;
+
+    // DWT, CoreDebug and SysTick are core registers, not RCC bus traffic
+    return Addr < Dwt;
+}
+
+/**
+ * @brief Maps a simulated register to its address on the STM32F446.
+ */
+static uint32_t PhysAddr(const volatile uint32_t *Reg) {
+    uintptr_t Addr = (uintptr_t)Reg;
+
+    if (Addr >= (uintptr_t)&RCCSim_Regs.GpioC) {
+        return GPIOC_BASE_ADDRESS + (uint32_t)(Addr - (uintptr_t)&RCCSim_Regs.GpioC);
+    }
+    if (Addr >= (uintptr_t)&RCCSim_Regs.GpioA) {
+        return GPIOA_BASE_ADDRESS + (uint32_t)(Addr - (uintptr_t)&RCCSim_Regs.GpioA);
+    }
+    if (Addr >= (uintptr_t)&RCCSim_Regs.Tim11) {
+        return TIM11_BASE_ADDRESS + (uint32_t)(Addr - (uintptr_t)&RCCSim_Regs.Tim11);
+    }
+    if (Addr >= (uintptr_t)&RCCSim_Regs.Tim5) {
+        return TIM5_BASE_ADDRESS + (uint32_t)(Addr - (uintptr_t)&RCCSim_Regs.Tim5);
+    }
+    if (Addr >= (uintptr_t)&RCCSim_Regs.Pwr) {
+        return PWR_BASE_ADDRESS + (uint32_t)(Addr - (uintptr_t)&RCCSim_Regs.Pwr);
+    }
+    if (Addr >= (uintptr_t)&RCCSim_Regs.Flash) {
+        return FLASH_R_BASE_ADDRESS + (uint32_t)(Addr - (uintptr_t)&RCCSim_Regs.Flash);
+    }
+    return RCC_BASE_ADDRESS + (uint32_t)(Addr - (uintptr_t)&RCCSim_Regs.Rcc);
+}
+
+static void PutU32(uint8_t *Buf, uint32_t Value) {
+    Buf[0] = (uint8_t)Value;
+    Buf[1] = (uint8_t)(Value >> 8);
+    Buf[2] = (uint8_t)(Value >> 16);
+    Buf[3] = (uint8_t)(Value >> 24);
+}
+
+/**
+ * @brief Appends one access to the open trace file.
+ */
+static void TraceRecord(const volatile uint32_t *Reg, uint32_t Value, uint32_t Write) {
+    uint8_t Rec[RCCSIM_TRACE_REC_SIZE];
+
+    if (TraceFile == NULL) {
+        return;
+    }
+    PutU32(&Rec[0], TraceSeq++);
+    PutU32(&Rec[4], PhysAddr(Reg) | Write);
+    PutU32(&Rec[8], Value);
+    fwrite(Rec, sizeof(Rec), 1, TraceFile);
+}
+
+/**
+ * @brief Forces the bits of the stuck-at faults into the stored registers.
+ */
+static void ApplyStuckFaults(void) {
+    uint32_t Idx;
+
+    for (Idx = 0; Idx < RCCSIM_MAX_FAULTS; Idx++) {
+        if (!Faults[Idx].Armed) {
+            continue;
+        }
+        if (Faults[Idx].Fault.Type == RCCSIM_FAULT_STUCK_LOW) {
+            *Faults[Idx].Fault.Reg &= ~Faults[Idx].Fault.Mask;
+        } else if (Faults[Idx].Fault.Type == RCCSIM_FAULT_STUCK_HIGH) {
+            *Faults[Idx].Fault.Reg |= Faults[Idx].Fault.Mask;
+        }
+    }
+}
+
+/**
+ * @brief Updates the read-only ready/status bits from the control bits.
+ */
+static void UpdateStatus(void) {
+    RCC_RegDef_t *Rcc = &RCCSim_Regs.Rcc;
+    uint32_t      CR = Rcc->CR;
+    uint32_t      Sw;
+    uint32_t      Ready;
+
+    // Oscillator / PLL ready flags follow their enable bits
+    CR &= ~(BIT(1) | BIT(17) | BIT(25) | BIT(27) | BIT(29));
+    CR |= ((CR >> 0) & 1) << 1;
+    CR |= ((CR >> 16) & 1) << 17;
+    CR |= ((CR >> 24) & 1) << 25;
+    CR |= ((CR >> 26) & 1) << 27;
+    CR |= ((CR >> 28) & 1) << 29;
+    Rcc->CR = CR;
+    ApplyStuckFaults();  // A stuck ready flag also blocks the SWS switch below
+    CR = Rcc->CR;
+
+    // The system clock switch completes only when the selected source is ready
+    Sw = Rcc->CFGR & 0x3;
+    switch (Sw) {
+        case 0:  Ready = (CR >> 1) & 1;  break;
+        case 1:  Ready = (CR >> 17) & 1; break;
+        default: Ready = (CR >> 25) & 1; break;
+    }
+    if (Ready) {
+        Rcc->CFGR = (Rcc->CFGR & ~(0x3UL << 2)) | (Sw << 2);
+    }
+
+    // LSERDY follows LSEON; LSERDYF is raised on the rising edge when LSERDYIE is set
+    if ((Rcc->BDCR & BIT(0)) != 0 && (Rcc->BDCR & BIT(1)) == 0 && (Rcc->CIR & BIT(9)) != 0) {
+        Rcc->CIR |= BIT(1);
+    }
+    Rcc->BDCR = (Rcc->BDCR & ~BIT(1)) | ((Rcc->BDCR & BIT(0)) << 1);
+    Rcc->CSR = (Rcc->CSR & ~BIT(1)) | ((Rcc->CSR & BIT(0)) << 1);      // LSIRDY
+
+    // PWR over-drive: ODRDY follows ODEN, ODSWRDY follows ODSWEN once ODRDY is set
+    RCCSim_Regs.Pwr.CSR &= ~(BIT(16) | BIT(17));
+    RCCSim_Regs.Pwr.CSR |= RCCSim_Regs.Pwr.CR & BIT(16);
+    if ((RCCSim_Regs.Pwr.CSR & BIT(16)) != 0) {
+        RCCSim_Regs.Pwr.CSR |= RCCSim_Regs.Pwr.CR & BIT(17);
+    }
+
+    ApplyStuckFaults();
+}
+
+/**
+ * @brief Returns the true SYSCLK frequency from the registers and the oscillator model.
+ */
+static uint32_t SimSysClk(void) {
+    RCC_RegDef_t *Rcc = &RCCSim_Regs.Rcc;
+    int64_t       Hsi = (int64_t)RCCSim_Osc.Hsi + (int64_t)RCCSim_Osc.HsiTrimStep * (int64_t)(((Rcc->CR >> 3) & 0x1F) - 16);
+    uint64_t      Src;
+    uint32_t      PllM = Rcc->PLLCFGR & 0x3F;
+    uint32_t      PllN = (Rcc->PLLCFGR >> 6) & 0x1FF;
+    uint32_t      PllDiv;
+
+    switch ((Rcc->CFGR >> 2) & 0x3) {
+        case 0:  return (uint32_t)Hsi;
+        case 1:  return RCCSim_Osc.Hse;
+        case 2:  PllDiv = (((Rcc->PLLCFGR >> 16) & 0x3) + 1) * 2; break;
+        default: PllDiv = (Rcc->PLLCFGR >> 28) & 0x7;             break;
+    }
+    Src = (Rcc->PLLCFGR & BIT(22)) ? RCCSim_Osc.Hse : (uint64_t)Hsi;
+    if (PllM == 0 || PllDiv == 0) {
+        return 0;
+    }
+    return (uint32_t)(Src * PllN / PllM / PllDiv);
+}
+
+/**
+ * @brief Returns the true kernel clock of the timers on APB1 or APB2.
+ */
+static uint32_t SimTimerClk(int Apb2) {
+    static const uint16_t AhbDiv[8] = {2, 4, 8, 16, 64, 128, 256, 512};
+    uint32_t              CFGR = RCCSim_Regs.Rcc.CFGR;
+    uint32_t              Hclk = SimSysClk();
+    uint32_t              Ppre = Apb2 ? ((CFGR >> 13) & 0x7) : ((CFGR >> 10) & 0x7);
+    uint32_t              ApbDiv = (Ppre & 0x4) ? (2UL << (Ppre & 0x3)) : 1;
+
+    if (CFGR & BIT(7)) {
+        Hclk /= AhbDiv[(CFGR >> 4) & 0x7];
+    }
+    if (RCCSim_Regs.Rcc.DCKCFGR & BIT(24)) {
+        return (ApbDiv <= 4) ? Hclk : Hclk / ApbDiv * 4;
+    }
+    return (ApbDiv == 1) ? Hclk : Hclk / ApbDiv * 2;
+}
+
+/**
+ * @brief Produces the next input capture of TIM5 CH4 or TIM11 CH1 when one is due.
+ *
+ * The model skips the waiting: every poll of SR with the flag clear delivers the next
+ * capture, after the number of source periods set by IC4PSC / IC1PSC, with the counter
+ * advanced by the exact number of timer ticks those periods took.
+ */
+static void SimCapture(int Tim11) {
+    RCC_RegDef_t *Rcc = &RCCSim_Regs.Rcc;
+    TIM_RegDef_t *Tim = Tim11 ? &RCCSim_Regs.Tim11 : &RCCSim_Regs.Tim5;
+    uint32_t      Flag = Tim11 ? BIT(1) : BIT(4);
+    uint32_t      Psc = Tim11 ? ((Tim->CCMR1 >> 2) & 0x3) : ((Tim->CCMR2 >> 10) & 0x3);
+    uint32_t      Rtcpre = (Rcc->CFGR >> 16) & 0x1F;
+    uint32_t      SrcFreq = 0;
+    uint64_t      Ticks;
+
+    if ((Tim->CR1 & BIT(0)) == 0 || (Tim->SR & Flag) != 0 ||
+        (Tim11 ? (Rcc->APB2ENR & BIT(18)) : (Rcc->APB1ENR & BIT(3))) == 0 ||  // TIM11EN, TIM5EN
+        (Tim11 ? (Tim->CCER & BIT(0)) : (Tim->CCER & BIT(12))) == 0) {
+        return;
+    }
+    if (Tim11 && (Tim->OR & 0x3) == 2 && (Rcc->CR & BIT(17)) && Rtcpre >= 2) {
+        SrcFreq = RCCSim_Osc.Hse / Rtcpre;
+    } else if (!Tim11 && ((Tim->OR >> 6) & 0x3) == 1 && (Rcc->CSR & BIT(1))) {
+        SrcFreq = RCCSim_Osc.Lsi;
+    } else if (!Tim11 && ((Tim->OR >> 6) & 0x3) == 2 && (Rcc->BDCR & BIT(1))) {
+        SrcFreq = RCCSim_Osc.Lse;
+    }
+    if (SrcFreq == 0) {
+        return;  // No clock on the input: the capture never comes
+    }
+
+    CapturePhase[Tim11] += (uint64_t)SimTimerClk(Tim11) * (1UL << Psc);
+    Ticks = CapturePhase[Tim11] / SrcFreq;
+    CapturePhase[Tim11] %= SrcFreq;
+    if (Tim11) {
+        Tim->CCR1 = (uint32_t)((Tim->CCR1 + Ticks) % ((uint64_t)Tim->ARR + 1));
+    } else {
+        Tim->CCR4 = (uint32_t)((Tim->CCR4 + Ticks) % ((uint64_t)Tim->ARR + 1));
+    }
+    Tim->SR |= Flag;
+}
+
+/**
+ * @brief Counts one access towards the pending CSS faults and fires the due ones.
+ */
+static void TickCSSFaults(void) {
+    uint32_t Idx;
+
+    for (Idx = 0; Idx < RCCSIM_MAX_FAULTS; Idx++) {
+        if (Faults[Idx].Armed && Faults[Idx].Fault.Type == RCCSIM_FAULT_CSS &&
+            ++Faults[Idx].Accesses >= Faults[Idx].Fault.Count) {
+            Faults[Idx].Armed = 0;  // One-shot
+            RCCSim_TriggerCSS();
+        }
+    }
+}
+
+void RCCSim_Reset(void) {
+    memset(&RCCSim_Regs, 0, sizeof(RCCSim_Regs));
+
+    RCCSim_Regs.Rcc.CR = 0x00000083UL;           // HSION, HSIRDY, HSITRIM = 16
+    RCCSim_Regs.Rcc.PLLCFGR = 0x24003010UL;
+    RCCSim_Regs.Rcc.AHB1ENR = 0x00100000UL;
+    RCCSim_Regs.Rcc.AHB1LPENR = 0x606790FFUL;    // Every peripheral clocked in Sleep
+    RCCSim_Regs.Rcc.AHB2LPENR = 0x00000081UL;
+    RCCSim_Regs.Rcc.AHB3LPENR = 0x00000003UL;
+    RCCSim_Regs.Rcc.APB1LPENR = 0x3FFFC9FFUL;
+    RCCSim_Regs.Rcc.APB2LPENR = 0x00C77F33UL;
+    RCCSim_Regs.Rcc.CSR = 0x0E000000UL;          // POR: PORRSTF, PINRSTF, BORRSTF
+    RCCSim_Regs.Rcc.PLLI2SCFGR = 0x24003010UL;
+    RCCSim_Regs.Rcc.PLLSAICFGR = 0x04003010UL;
+    RCCSim_Regs.Pwr.CR = 0x0000C000UL;           // VOS = scale 1
+    RCCSim_Regs.GpioA.MODER = 0xA8000000UL;      // PA13..PA15: debug port
+    RCCSim_Regs.GpioA.OSPEEDR = 0x0C000000UL;
+    RCCSim_Regs.GpioA.PUPDR = 0x64000000UL;
+    RCCSim_Regs.Dwt.CTRL = 0x40000000UL;
+
+    RCCSim_Osc.Hsi = 16000000UL;
+    RCCSim_Osc.HsiTrimStep = 40000;
+    RCCSim_Osc.Hse = 8000000UL;
+    RCCSim_Osc.Lse = 32768UL;
+    RCCSim_Osc.Lsi = 32000UL;
+    CapturePhase[0] = 0;
+    CapturePhase[1] = 0;
+
+    RCCSim_ClearFaults();
+    RCCSim_ClearCounters();
+}
+
+uint8_t RCCSim_InjectFault(const RCCSIM_FAULT_t *Fault) {
+    uint32_t Idx;
+
+    if (Fault == NULL || Fault->Type > RCCSIM_FAULT_CSS ||
+        (Fault->Type != RCCSIM_FAULT_CSS && Fault->Reg == NULL)) {
+        return 1;
+    }
+    for (Idx = 0; Idx < RCCSIM_MAX_FAULTS; Idx++) {
+        if (!Faults[Idx].Armed) {
+            Faults[Idx].Fault = *Fault;
+            Faults[Idx].Reads = 0;
+            Faults[Idx].Accesses = 0;
+            Faults[Idx].Armed = 1;
+            UpdateStatus();
+            return 0;
+        }
+    }
+    return 1;  // Table full
+}
+
+uint8_t RCCSim_TraceOpen(const char *Path) {
+    uint8_t Hdr[RCCSIM_TRACE_HDR_SIZE];
+
+    RCCSim_TraceClose();
+    TraceFile = fopen(Path, "wb");
+    if (TraceFile == NULL) {
+        return 1;
+    }
+    memcpy(Hdr, RCCSIM_TRACE_MAGIC, 4);
+    PutU32(&Hdr[4], RCCSIM_TRACE_VERSION);
+    fwrite(Hdr, sizeof(Hdr), 1, TraceFile);
+    TraceSeq = 0;
+    return 0;
+}
+
+void RCCSim_TraceClose(void) {
+    if (TraceFile != NULL) {
+        fclose(TraceFile);
+        TraceFile = NULL;
+    }
+}
+
+void RCCSim_ClearFaults(void) {
+    memset(Faults, 0, sizeof(Faults));
+}
+
+void RCCSim_TriggerCSS(void) {
+    RCC_RegDef_t *Rcc = &RCCSim_Regs.Rcc;
+
+    if ((Rcc->CR & BIT(19)) == 0) {
+        return;  // CSS off: the failure goes unnoticed
+    }
+    if ((Rcc->PLLCFGR & BIT(22)) != 0) {
+        Rcc->CR &= ~BIT(24);  // PLL runs from HSE and stops with it
+    }
+    Rcc->CR &= ~(BIT(16) | BIT(19));
+    Rcc->CFGR &= ~0x3UL;      // SW = HSI
+    Rcc->CIR |= BIT(7);       // CSSF
+    UpdateStatus();
+}
+
+void RCCSim_ClearCounters(void) {
+    memset(&Counters, 0, sizeof(Counters));
+}
+
+const RCCSIM_COUNTERS_t *RCCSim_GetCounters(void) {
+    return &Counters;
+}
+
+uint32_t RCCSim_Read(volatile uint32_t *Reg) {
+    uint32_t Value;
+    uint32_t Idx;
+
+    if (REG_IS(Reg, Dwt.CYCCNT)) {
+        Counters.Cycles += RCCSIM_CYCCNT_CYCLES;
+        return (uint32_t)Counters.Cycles;
+    }
+    if (IsCounted(Reg)) {
+        Counters.Reads++;
+        Counters.Cycles += RCCSIM_READ_CYCLES;
+        TickCSSFaults();
+    }
+    if (REG_IS(Reg, Tim5.SR) || REG_IS(Reg, Tim11.SR)) {
+        SimCapture(REG_IS(Reg, Tim11.SR));
+    }
+
+    Value = *Reg;
+    if (REG_IS(Reg, Tim5.CCR4)) {
+        RCCSim_Regs.Tim5.SR &= ~BIT(4);   // Reading the capture clears CC4IF
+    } else if (REG_IS(Reg, Tim11.CCR1)) {
+        RCCSim_Regs.Tim11.SR &= ~BIT(1);  // Reading the capture clears CC1IF
+    }
+    for (Idx = 0; Idx < RCCSIM_MAX_FAULTS; Idx++) {
+        if (!Faults[Idx].Armed || Faults[Idx].Fault.Reg != Reg) {
+            continue;
+        }
+        Faults[Idx].Reads++;
+        if (Faults[Idx].Fault.Type == RCCSIM_FAULT_DELAY && Faults[Idx].Reads <= Faults[Idx].Fault.Count) {
+            Value &= ~Faults[Idx].Fault.Mask;
+        } else if (Faults[Idx].Fault.Type == RCCSIM_FAULT_FLIP &&
+                   (Faults[Idx].Fault.Count == 0 || Faults[Idx].Reads == Faults[Idx].Fault.Count)) {
+            Value ^= Faults[Idx].Fault.Mask;
+        }
+    }
+    if (IsCounted(Reg)) {
+        TraceRecord(Reg, Value, 0);
+    }
+    return Value;
+}
+
+void RCCSim_Write(volatile uint32_t *Reg, uint32_t Value) {
+    RCC_RegDef_t *Rcc = &RCCSim_Regs.Rcc;
+
+    uint32_t      Idx;
+
+    if (IsCounted(Reg)) {
+        Counters.Writes++;
+        Counters.Cycles += RCCSIM_WRITE_CYCLES;
+        TraceRecord(Reg, Value, RCCSIM_TRACE_WRITE);
+        TickCSSFaults();
+    }
+    for (Idx = 0; Idx < RCCSIM_MAX_FAULTS; Idx++) {
+        if (Faults[Idx].Armed && Faults[Idx].Fault.Type == RCCSIM_FAULT_DELAY && Faults[Idx].Fault.Reg == Reg) {
+            Faults[Idx].Reads = 0;  // The delay restarts with every control write
+        }
+    }
+
+    if (REG_IS(Reg, Rcc.CR)) {
+        // HSEBYP can only change while HSE is off
+        if ((Rcc->CR & BIT(16)) != 0) {
+            Value = (Value & ~BIT(18)) | (Rcc->CR & BIT(18));
+        }
+        Rcc->CR = (Rcc->CR & ~CR_WRITABLE) | (Value & CR_WRITABLE);
+    } else if (REG_IS(Reg, Rcc.CFGR)) {
+        Rcc->CFGR = (Rcc->CFGR & ~CFGR_WRITABLE) | (Value & CFGR_WRITABLE);
+    } else if (REG_IS(Reg, Rcc.CIR)) {
+        // Flags are read-only, the clear bits (16..23) acknowledge them
+        Rcc->CIR = ((Rcc->CIR & 0xFFUL) & ~((Value >> 16) & 0xFFUL)) | (Value & CIR_ENABLES);
+    } else if (REG_IS(Reg, Rcc.BDCR)) {
+        if ((RCCSim_Regs.Pwr.CR & BIT(8)) == 0) {
+            // Write-protected until DBP is set in PWR_CR
+        } else if ((Value & BIT(16)) != 0) {
+            Rcc->BDCR = BIT(16);  // Backup domain reset
+        } else {
+            Rcc->BDCR = (Rcc->BDCR & ~BDCR_WRITABLE) | (Value & BDCR_WRITABLE);
+        }
+    } else if (REG_IS(Reg, Rcc.CSR)) {
+        Rcc->CSR = (Rcc->CSR & ~CSR_WRITABLE) | (Value & CSR_WRITABLE);
+        if ((Value & BIT(24)) != 0) {
+            Rcc->CSR &= ~CSR_RESET_FLAGS;  // RMVF
+        }
+    } else if (REG_IS(Reg, Tim5.SR) || REG_IS(Reg, Tim11.SR)) {
+        *Reg &= Value;  // rc_w0: writing 0 clears a flag
+    } else if (REG_IS(Reg, Tim5.EGR) || REG_IS(Reg, Tim11.EGR)) {
+        // Write-only event bits
+    } else if (REG_IS(Reg, Pwr.CSR)) {
+        // Status register: nothing writable in the model
+    } else if (REG_IS(Reg, Dwt.CYCCNT)) {
+        Counters.Cycles = Value;
+    } else {
+        *Reg = Value;
+    }
+
+    UpdateStatus();
+}
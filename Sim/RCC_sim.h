@@ -0,0 +1,164 @@
+#ifndef RCC_SIM_H
+#define RCC_SIM_H
+
+#include <stdint.h>
+#include "STM32F446xx.h"
+
+/*
+ * Host simulator backend for the RCC driver.
+ *
+ * Compiling Src/RCC_prog.c with -DRCC_HOST_SIM routes every register access of the
+ * driver through RCCSim_Read()/RCCSim_Write(), which keep the register file below,
+ * model the ready/status bits of the hardware and count the bus traffic.
+ *
+ * Faults (stuck or late ready flags, read-back bit flips, spurious CSS events) can be
+ * scripted with RCCSim_InjectFault() to exercise the timeout and failover paths.
+ *
+ * TIM5 and TIM11 model only their input capture of LSI / LSE / HSE_RTC, clocked by the
+ * oscillator frequencies in RCCSim_Osc, so that clock measurements see a chosen error.
+ */
+
+/********************* Bus Cost Model (estimated Cortex-M4 cycles per access) *********************/
+#define RCCSIM_READ_CYCLES      3U   // LDR from an AHB1 peripheral incl. one bus wait state
+#define RCCSIM_WRITE_CYCLES     2U   // STR through the write buffer to an AHB1 peripheral
+#define RCCSIM_CYCCNT_CYCLES    1U   // Time that passes per read of DWT CYCCNT (lets busy-waits end)
+
+/********************* Simulated Register File *********************/
+typedef struct
+{
+    RCC_RegDef_t       Rcc;
+    FLASH_RegDef_t     Flash;
+    PWR_RegDef_t       Pwr;
+    TIM_RegDef_t       Tim5;
+    TIM_RegDef_t       Tim11;
+    GPIO_RegDef_t      GpioA;
+    GPIO_RegDef_t      GpioC;
+    DWT_RegDef_t       Dwt;
+    CoreDebug_RegDef_t CoreDebug;
+    SysTick_RegDef_t   SysTick;
+
+}RCCSIM_REGS_t;
+
+/********************* Access Counters *********************/
+typedef struct
+{
+    uint32_t Reads;    // Volatile reads of RCC / FLASH / PWR / TIM / GPIO registers
+    uint32_t Writes;   // Volatile writes of RCC / FLASH / PWR / TIM / GPIO registers
+    uint64_t Cycles;   // Estimated cycles spent on those accesses and CYCCNT polls (drives DWT CYCCNT)
+
+}RCCSIM_COUNTERS_t;
+
+/********************* Fault Injection *********************/
+typedef enum
+{
+    RCCSIM_FAULT_STUCK_LOW = 0,   // Mask bits of Reg always read 0 (ready flag never sets)
+    RCCSIM_FAULT_STUCK_HIGH,      // Mask bits of Reg always read 1
+    RCCSIM_FAULT_DELAY,           // Mask bits of Reg read 0 for Count reads after each write to Reg
+    RCCSIM_FAULT_FLIP,            // Mask bits of Reg are inverted on read number Count (0: every read)
+    RCCSIM_FAULT_CSS              // HSE failure after Count further register accesses (Reg/Mask unused)
+
+}RCCSIM_FAULT_TYPE_t;
+
+typedef struct
+{
+    RCCSIM_FAULT_TYPE_t Type;
+    volatile uint32_t  *Reg;     // Simulated register, e.g. &RCCSim_Regs.Rcc.CR
+    uint32_t            Mask;    // Affected bits
+    uint32_t            Count;   // Reads / accesses, see RCCSIM_FAULT_TYPE_t
+
+}RCCSIM_FAULT_t;
+
+#define RCCSIM_MAX_FAULTS       8U
+
+/********************* Oscillator Model *********************/
+/*
+ * True frequencies of the simulated oscillators in Hz; RCCSim_Reset() sets the nominal
+ * values. They only drive the timer captures: the driver keeps computing frequencies
+ * from the registers and RCC_HSE_FREQ, so changing Hse or Lse models a crystal error.
+ */
+typedef struct
+{
+    uint32_t Hsi;          // HSI at HSITRIM = 16
+    int32_t  HsiTrimStep;  // HSI change per HSITRIM step
+    uint32_t Hse;
+    uint32_t Lse;
+    uint32_t Lsi;
+
+}RCCSIM_OSC_t;
+
+/********************* Access Trace File Format *********************/
+/*
+ * An 8-byte header (magic "RCCT", little-endian version) followed by one 12-byte
+ * record per RCC / FLASH / PWR access, all fields little-endian uint32_t:
+ *   Seq    access number, starting at 0 when the trace is opened
+ *   Addr   physical register address; bit 0 is set for a write (addresses are word aligned)
+ *   Value  value read (after fault injection) or written
+ * Tools/RCC_tracediff dumps and compares these files.
+ */
+#define RCCSIM_TRACE_MAGIC      "RCCT"
+#define RCCSIM_TRACE_VERSION    1U
+#define RCCSIM_TRACE_HDR_SIZE   8U
+#define RCCSIM_TRACE_REC_SIZE   12U
+#define RCCSIM_TRACE_WRITE      0x1UL
+
+extern RCCSIM_REGS_t RCCSim_Regs;
+extern RCCSIM_OSC_t  RCCSim_Osc;
+
+/**
+ * @brief Puts every simulated register back to its reset value and clears the counters.
+ */
+void RCCSim_Reset(void);
+
+/**
+ * @brief Arms a scripted fault; it stays active until RCCSim_ClearFaults() or RCCSim_Reset().
+ *
+ * @return 0 on success, 1 if the fault table is full or the fault is malformed.
+ */
+uint8_t RCCSim_InjectFault(const RCCSIM_FAULT_t *Fault);
+
+/**
+ * @brief Disarms every injected fault.
+ */
+void RCCSim_ClearFaults(void);
+
+/**
+ * @brief Simulates an HSE failure detected by the clock security system.
+ *
+ * Like the hardware: HSE (and the PLL when it runs from HSE) stops, SYSCLK falls back
+ * to HSI and CSSF is set in RCC_CIR when CSSON was set.
+ */
+void RCCSim_TriggerCSS(void);
+
+/**
+ * @brief Starts recording every counted register access to a binary trace file.
+ *
+ * @return 0 on success, 1 if the file cannot be created.
+ */
+uint8_t RCCSim_TraceOpen(const char *Path);
+
+/**
+ * @brief Stops recording and closes the trace file (no effect when none is open).
+ */
+void RCCSim_TraceClose(void);
+
+/**
+ * @brief Clears the access counters without touching the registers.
+ */
+void RCCSim_ClearCounters(void);
+
+/**
+ * @brief Returns the access counters accumulated since the last clear.
+ */
+const RCCSIM_COUNTERS_t *RCCSim_GetCounters(void);
+
+/**
+ * @brief Reads a simulated register (used by RCC_READ under RCC_HOST_SIM).
+ */
+uint32_t RCCSim_Read(volatile uint32_t *Reg);
+
+/**
+ * @brief Writes a simulated register and applies the hardware model (used by RCC_WRITE).
+ */
+void RCCSim_Write(volatile uint32_t *Reg, uint32_t Value);
+
+#endif // RCC_SIM_H
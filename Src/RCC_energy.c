@@ -0,0 +1,126 @@
+#include <stdint.h>
+#include "RCC_private.h"
+#include "RCC_energy.h"
+
+/*
+ * Per-peripheral dynamic current in nA per MHz of the bus clock, indexed by the
+ * enable bit. APPROXIMATE typical values rounded from the DS10693 peripheral
+ * current consumption table (timers counted at their bus clock); bits without an
+ * entry (reserved bits, memory interfaces) count 0.
+ */
+static const uint16_t RCC_EnergyAhb1[32] = {
+    [GPIOAEN] = 2200, [GPIOBEN] = 2200, [GPIOCEN] = 2200, [GPIODEN] = 2200,
+    [GPIOEEN] = 2200, [GPIOFEN] = 2200, [GPIOGEN] = 2200, [GPIOHEN] = 2200,
+    [CRCEN]   = 600,  [SRAM]    = 600,  [DMA1EN]  = 11000, [DMA2EN] = 11500,
+    [OTGHSEN] = 26000, [OTGHSULPIEN] = 12000
+};
+
+static const uint16_t RCC_EnergyAhb2[32] = {
+    [DCMIEN] = 3800, [OTGFSEN] = 24000
+};
+
+static const uint16_t RCC_EnergyAhb3[32] = {
+    [FMCEN] = 12000, [QSPIEN] = 10000
+};
+
+static const uint16_t RCC_EnergyApb1[32] = {
+    [TIM2EN]   = 6500, [TIM3EN]   = 5200, [TIM4EN]    = 5200, [TIM5EN]   = 6500,
+    [TIM6EN]   = 1200, [TIM7EN]   = 1200, [TIM12EN]   = 3100, [TIM13EN]  = 2200,
+    [TIM14EN]  = 2200, [WWDGEN]   = 700,  [SPI2EN]    = 2500, [SPI3EN]   = 2500,
+    [SPDIFRXEN]= 2200, [USART2EN] = 3100, [USART3EN]  = 3100, [UART4EN]  = 3100,
+    [UART5EN]  = 3100, [I2C1EN]   = 3200, [I2C2EN]    = 3200, [I2C3EN]   = 3200,
+    [FMPI2C1EN]= 3500, [CAN1EN]   = 4500, [CAN2EN]    = 4200, [CECEN]    = 900,
+    [PWREN]    = 700,  [DACEN]    = 1500
+};
+
+static const uint16_t RCC_EnergyApb2[32] = {
+    [TIM1EN]   = 9000, [TIM8EN]   = 9200, [USART1EN]  = 3200, [USART6EN] = 3200,
+    [ADC1EN]   = 4000, [ADC2EN]   = 4000, [ADC3EN]    = 4000, [SDIOEN]   = 6000,
+    [SPI1EN]   = 1600, [SPI4EN]   = 1700, [SYSCFGEN]  = 800,  [TIM9EN]   = 3000,
+    [TIM10EN]  = 1800, [TIM11EN]  = 1800, [SAI1EN]    = 2600, [SAI2EN]   = 2600
+};
+
+/**
+ * @brief Returns the current in uA of the peripherals enabled in Enr on one bus.
+ */
+static uint32_t RCC_EnergyBus(const uint16_t Coef[32], uint32_t Enr, uint32_t BusHz) {
+    uint64_t NaPerMHz = 0;
+    uint8_t  Bit;
+
+    for (Bit = 0; Bit < 32; Bit++) {
+        if (Enr & (1UL << Bit)) {
+            NaPerMHz += Coef[Bit];
+        }
+    }
+    return (uint32_t)((NaPerMHz * BusHz) / 1000000000ULL);  // nA/MHz x Hz -> uA
+}
+
+/**
+ * @brief Returns the current in uA of the peripherals enabled in the given words.
+ */
+static uint32_t RCC_EnergyPeriph(const RCC_CLK_STATE_t *State, uint32_t Ahb1, uint32_t Ahb2,
+                                 uint32_t Ahb3, uint32_t Apb1, uint32_t Apb2) {
+    return RCC_EnergyBus(RCC_EnergyAhb1, Ahb1, State->HClk) +
+           RCC_EnergyBus(RCC_EnergyAhb2, Ahb2, State->HClk) +
+           RCC_EnergyBus(RCC_EnergyAhb3, Ahb3, State->HClk) +
+           RCC_EnergyBus(RCC_EnergyApb1, Apb1, State->PClk1) +
+           RCC_EnergyBus(RCC_EnergyApb2, Apb2, State->PClk2);
+}
+
+/**
+ * @brief Estimates the supply current of a clock tree state.
+ *
+ * Run: core (fixed + per MHz of HCLK) + running oscillators and PLLs + every
+ * peripheral enabled in AHBxENR/APBxENR at its bus clock. Sleep: the Sleep core
+ * coefficients, the same oscillators and only the peripherals also enabled in
+ * AHBxLPENR/APBxLPENR.
+ *
+ * @param State The oscillators, peripheral enables and bus clocks to evaluate.
+ * @param Estimate Receives the Run and Sleep currents and the Run breakdown in uA.
+ * @return uint8_t Returns 0 on success, 1 if a pointer is null.
+ */
+uint8_t RCC_Energy_Estimate(const RCC_CLK_STATE_t *State, RCC_ENERGY_t *Estimate) {
+    uint32_t HClkMHz;
+    uint32_t Osc = 0;
+
+    if (State == 0 || Estimate == 0) {
+        return 1;  // Nothing to evaluate
+    }
+    HClkMHz = State->HClk / 1000000UL;
+
+    if (State->CR & (1 << 0)) {
+        Osc += RCC_ENERGY_HSI_UA;                           // HSION
+    }
+    if ((State->CR & ((1 << 16) | (1 << 18))) == (1 << 16)) {
+        Osc += RCC_ENERGY_HSE_UA;                           // HSEON with a crystal
+    }
+    if (State->CR & (1 << 24)) {
+        Osc += RCC_ENERGY_PLL_UA;                           // PLLON
+    }
+    if (State->CR & (1 << 26)) {
+        Osc += RCC_ENERGY_PLL_UA;                           // PLLI2SON
+    }
+    if (State->CR & (1 << 28)) {
+        Osc += RCC_ENERGY_PLL_UA;                           // PLLSAION
+    }
+    if ((State->BDCR & ((1 << 0) | (1 << 2))) == (1 << 0)) {
+        Osc += RCC_ENERGY_LSE_UA;                           // LSEON with a crystal
+    }
+    if (State->CSR & (1 << 0)) {
+        Osc += RCC_ENERGY_LSI_UA;                           // LSION
+    }
+
+    Estimate->CoreUa   = RCC_ENERGY_RUN_BASE_UA + RCC_ENERGY_RUN_UA_PER_MHZ * HClkMHz;
+    Estimate->OscUa    = Osc;
+    Estimate->PeriphUa = RCC_EnergyPeriph(State, State->AHB1ENR, State->AHB2ENR, State->AHB3ENR,
+                                          State->APB1ENR, State->APB2ENR);
+    Estimate->RunUa    = Estimate->CoreUa + Estimate->OscUa + Estimate->PeriphUa;
+    Estimate->SleepUa  = RCC_ENERGY_SLEEP_BASE_UA + RCC_ENERGY_SLEEP_UA_PER_MHZ * HClkMHz + Osc +
+                         RCC_EnergyPeriph(State, State->AHB1ENR & State->AHB1LPENR,
+                                          State->AHB2ENR & State->AHB2LPENR,
+                                          State->AHB3ENR & State->AHB3LPENR,
+                                          State->APB1ENR & State->APB1LPENR,
+                                          State->APB2ENR & State->APB2LPENR);
+
+    return 0;  // Success
+}
@@ -1,8 +1,143 @@
 #include <stdint.h>
 #include "RCC_private.h"
+#include "RCC_config.h"
 #include "STM32F446xx.h"
 
+#ifdef RCC_HOST_SIM
+/* Host build: registers live in the simulator and every access goes through it */
+#include "RCC_sim.h"
+
+#define RCC         (&RCCSim_Regs.Rcc)
+#define FLASH       (&RCCSim_Regs.Flash)
+#define PWR         (&RCCSim_Regs.Pwr)
+#define TIM5        (&RCCSim_Regs.Tim5)
+#define TIM11       (&RCCSim_Regs.Tim11)
+#undef  GPIOA
+#undef  GPIOC
+#define GPIOA       (&RCCSim_Regs.GpioA)
+#define GPIOC       (&RCCSim_Regs.GpioC)
+#define DWT         (&RCCSim_Regs.Dwt)
+#define COREDEBUG   (&RCCSim_Regs.CoreDebug)
+#define SYSTICK     (&RCCSim_Regs.SysTick)
+
+#define RCC_READ(REG)           RCCSim_Read(&(REG))
+#define RCC_WRITE(REG, VAL)     RCCSim_Write(&(REG), (VAL))
+#else
 #define RCC     ((RCC_RegDef_t*)RCC_BASE_ADDRESS)
+#define FLASH   ((FLASH_RegDef_t*)FLASH_R_BASE_ADDRESS)
+#define PWR     ((PWR_RegDef_t*)PWR_BASE_ADDRESS)
+#define TIM5    ((TIM_RegDef_t*)TIM5_BASE_ADDRESS)
+#define TIM11   ((TIM_RegDef_t*)TIM11_BASE_ADDRESS)
+
+#define DWT         ((DWT_RegDef_t*)DWT_BASE_ADDRESS)
+#define COREDEBUG   ((CoreDebug_RegDef_t*)COREDEBUG_BASE_ADDRESS)
+#define SYSTICK     ((SysTick_RegDef_t*)SYSTICK_BASE_ADDRESS)
+
+#define RCC_READ(REG)           (REG)
+#define RCC_WRITE(REG, VAL)     ((REG) = (VAL))
+#endif
+
+/**
+ * @brief Starts the DWT cycle counter used for probes, trace timestamps and RCC_DelayUs.
+ */
+static void RCC_CycleCounterStart(void) {
+    RCC_WRITE(COREDEBUG->DEMCR, RCC_READ(COREDEBUG->DEMCR) | (1UL << 24));  // TRCENA: enable the DWT unit
+    RCC_WRITE(DWT->CTRL, RCC_READ(DWT->CTRL) | (1UL << 0));                 // CYCCNTENA
+}
+
+static void RCC_ClockChanged(void);  // Refreshes the delay scale and SysTick after an HCLK change
+
+#if RCC_INSTRUMENTATION
+static RCC_STATS_t RCC_Stats;
+
+/**
+ * @brief Adds one cycle sample to a statistics entry.
+ */
+static void RCC_ProbeRecord(RCC_CYCLE_STAT_t *Stat, uint32_t Cycles) {
+    if (Stat->Count == 0 || Cycles < Stat->Min) {
+        Stat->Min = Cycles;
+    }
+    if (Cycles > Stat->Max) {
+        Stat->Max = Cycles;
+    }
+    Stat->Last = Cycles;
+    Stat->Count++;
+}
+
+#define RCC_PROBE_ENTRY()           uint32_t ProbeStart = RCC_READ(DWT->CYCCNT)
+#define RCC_PROBE_EXIT(OP)          RCC_ProbeRecord(&RCC_Stats.Op[OP], RCC_READ(DWT->CYCCNT) - ProbeStart)
+#else
+#define RCC_PROBE_ENTRY()           do { } while (0)
+#define RCC_PROBE_EXIT(OP)          do { } while (0)
+#endif
+
+/* Every return of a probed function goes through here, so failures are timed too */
+#define RCC_PROBE_RETURN(OP, VAL)   do { RCC_PROBE_EXIT(OP); return (VAL); } while (0)
+
+#if RCC_TRACE
+#if (RCC_TRACE_DEPTH & (RCC_TRACE_DEPTH - 1)) != 0
+#error "RCC_TRACE_DEPTH must be a power of two"
+#endif
+
+RCC_TRACE_t RCC_Trace;  // Global so a debugger can read it by symbol
+
+/**
+ * @brief Appends one record to the trace ring.
+ *
+ * The slot is claimed with an atomic increment of Head, so thread and interrupt
+ * context can both append without locking; Seq is published last so readers can
+ * tell a complete record from one that is still being written.
+ */
+static void RCC_TraceAppend(RCC_OP_t Op, uint32_t Arg, volatile uint32_t *Reg, uint32_t Old, uint32_t New) {
+    uint32_t            Idx = __atomic_fetch_add(&RCC_Trace.Head, 1U, __ATOMIC_RELAXED);
+    RCC_TRACE_RECORD_t *Rec = &RCC_Trace.Rec[Idx & (RCC_TRACE_DEPTH - 1U)];
+
+    Rec->Seq = 0;
+    Rec->Cycles = RCC_READ(DWT->CYCCNT);
+    Rec->Op = (uint8_t)Op;
+    Rec->Arg = (uint8_t)Arg;
+    Rec->Reg = (uint16_t)((uintptr_t)Reg - (uintptr_t)RCC);
+    Rec->Old = Old;
+    Rec->New = New;
+    __atomic_store_n(&Rec->Seq, Idx + 1U, __ATOMIC_RELEASE);
+}
+
+#define RCC_TRACE_SNAPSHOT(VAR, REG)          uint32_t VAR = (REG)
+#define RCC_TRACE_EVENT(OP, ARG, REG, OLD, NEW)   RCC_TraceAppend((OP), (ARG), &RCC->REG, (OLD), (NEW))
+#define RCC_TRACE_EVENT_AT(OP, ARG, PTR, OLD, NEW)   RCC_TraceAppend((OP), (ARG), (PTR), (OLD), (NEW))
+#else
+#define RCC_TRACE_SNAPSHOT(VAR, REG)          do { } while (0)
+#define RCC_TRACE_EVENT(OP, ARG, REG, OLD, NEW)   do { } while (0)
+#define RCC_TRACE_EVENT_AT(OP, ARG, PTR, OLD, NEW)   do { } while (0)
+#endif
+
+/**
+ * @brief Polls a status field until it reads Value or RCC_READY_TIMEOUT polls elapse.
+ *
+ * Only the stack is used, so the wait is safe in RCC_EarlyInit. With Probe set and
+ * RCC_INSTRUMENTATION enabled the time spent is recorded under Stage.
+ *
+ * @return uint8_t Returns 0 once (Reg & Mask) == Value, 1 on timeout.
+ */
+static inline uint8_t RCC_WaitFor(volatile uint32_t *Reg, uint32_t Mask, uint32_t Value, RCC_WAIT_t Stage, uint8_t Probe) {
+    uint32_t Polls = RCC_READY_TIMEOUT;
+#if RCC_INSTRUMENTATION
+    uint32_t WaitStart = Probe ? RCC_READ(DWT->CYCCNT) : 0;
+#else
+    (void)Stage;
+    (void)Probe;
+#endif
+
+    while ((RCC_READ(*Reg) & Mask) != Value && --Polls != 0) {
+    }
+
+#if RCC_INSTRUMENTATION
+    if (Probe) {
+        RCC_ProbeRecord(&RCC_Stats.Wait[Stage], RCC_READ(DWT->CYCCNT) - WaitStart);
+    }
+#endif
+    return (Polls == 0) ? 1 : 0;
+}
 
 /**
  * @brief Sets the status of the specified clock.
@@ -11,50 +146,108 @@
  *
  * @param Clk_Type The type of clock to set (HSI, HSE, PLL, etc.).
  * @param Status The status to set for the clock (ON, OFF).
- * @return uint8_t Returns 0 on success, 1 if the clock type is invalid.
+ * @return uint8_t Returns 0 on success, 1 if the ready flag did not follow within RCC_READY_TIMEOUT.
  */
 uint8_t RCC_SetClkStatus(CLK_t Clk_Type, STATUS_t Status) {
-    // Check if the clock type is within a valid range (HSI, HSE, PLL, etc.)
-
-
+    uint32_t Old;
+    uint32_t New;
+    RCC_PROBE_ENTRY();
 
     // Set or clear the appropriate bit in the RCC->CR register based on Status
+    Old = RCC_READ(RCC->CR);
     if (Status == ON) {
-        RCC->CR |= (1 << Clk_Type);  // Enable the specified clock
+        New = Old | (1 << Clk_Type);  // Enable the specified clock
     } else {
-        RCC->CR &= ~(1 << Clk_Type); // Disable the specified clock
+        New = Old & ~(1 << Clk_Type); // Disable the specified clock
     }
+    RCC_WRITE(RCC->CR, New);
+    RCC_TRACE_EVENT(RCC_OP_SET_CLK_STATUS, Clk_Type, CR, Old, New);
 
-    // Wait for the clock to be ready (bit is set in RCC->CR register)
-    while (((RCC->CR >> (Clk_Type + 1)) & 1) == 0);
+    // Wait for the ready bit in RCC->CR to follow the requested status
+    if (RCC_WaitFor(&RCC->CR, 1UL << (Clk_Type + 1), (uint32_t)Status << (Clk_Type + 1),
+                    (Clk_Type == HSE) ? RCC_WAIT_HSE_READY : (Clk_Type == PLL) ? RCC_WAIT_PLL_LOCK : RCC_WAIT_OSC_READY, 1)) {
+        RCC_PROBE_RETURN(RCC_OP_SET_CLK_STATUS, 1);  // Oscillator did not start (or stop) in time
+    }
 
-    return 0;  // Success
+    RCC_PROBE_RETURN(RCC_OP_SET_CLK_STATUS, 0);  // Success
 }
 
 /**
  * @brief Configures the system clock source.
  *
- * This function selects the clock source for the system clock (HSI, HSE, or PLL).
+ * This function selects the clock source for the system clock (HSI, HSE, PLLP or
+ * PLLR); the PLL must already be locked for the PLL outputs.
  *
- * @param SYSClkType The type of clock source to use (HSI, HSE, PLL).
- * @return uint8_t Returns 0 on success, 1 if the clock source is invalid.
+ * @param SYSClkType The type of clock source to use (SYSHSI, SYSHSE, SYSPLLP, SYSPLLR).
+ * @return uint8_t Returns 0 on success, 1 if the clock source is invalid or the switch timed out.
  */
 uint8_t RCC_SetSysClk(SYS_CLK_t SYSClkType) {
+    uint32_t Old;
+    uint32_t New;
+    RCC_PROBE_ENTRY();
+
     // Check if the system clock source is valid
-    if (SYSClkType > SYSPLLP) {
-        return 1;  // Return error for invalid system clock type
+    if ((unsigned)SYSClkType > SYSPLLR) {
+        RCC_PROBE_RETURN(RCC_OP_SET_SYSCLK, 1);  // Return error for invalid system clock type
     }
 
-    // Clear the current system clock selection bits (SW[1:0] in CFGR)
-    RCC->CFGR &= ~(0b11 << 0);
-
-    // Set the new system clock source (SYSClkType shifted into position)
-    RCC->CFGR |= (SYSClkType << 0);
+    // Replace the system clock selection bits (SW[1:0] in CFGR) in a single store
+    Old = RCC_READ(RCC->CFGR);
+    New = (Old & ~(0b11 << 0)) | (SYSClkType << 0);
+    RCC_WRITE(RCC->CFGR, New);
+    RCC_TRACE_EVENT(RCC_OP_SET_SYSCLK, SYSClkType, CFGR, Old, New);
 
     // Wait for the system clock to be switched and confirmed (SWS[1:0] bits)
-    while (((RCC->CFGR >> 2) & 0b11) != SYSClkType);
+    if (RCC_WaitFor(&RCC->CFGR, 0b11 << 2, (uint32_t)SYSClkType << 2, RCC_WAIT_SYSCLK_SWITCH, 1)) {
+        RCC_ClockChanged();  // SWS tells which clock actually runs
+        RCC_PROBE_RETURN(RCC_OP_SET_SYSCLK, 1);  // SWS never confirmed the new source (not ready or failed)
+    }
+    RCC_ClockChanged();
+
+    RCC_PROBE_RETURN(RCC_OP_SET_SYSCLK, 0);  // Success
+}
+
+/**
+ * @brief Returns the current system clock frequency.
+ *
+ * Decodes the switch status (SWS) and, for the PLL outputs, PLLCFGR. The HSE
+ * frequency is the board constant RCC_HSE_FREQ.
+ *
+ * @return uint32_t SYSCLK in Hz, 0 if the PLL factors in PLLCFGR are invalid.
+ */
+uint32_t RCC_GetSysClkFreq(void) {
+    uint32_t Sws;
+    uint32_t PLLCFGR;
+    uint32_t InFreq;
+    uint32_t M;
+    uint32_t Div;
+    uint32_t Freq;
+    RCC_PROBE_ENTRY();
+
+    Sws = (RCC_READ(RCC->CFGR) >> 2) & 0b11;
+    switch (Sws) {
+        case SYSHSI:
+            RCC_PROBE_RETURN(RCC_OP_GET_SYSCLK, RCC_HSI_FREQ);
+        case SYSHSE:
+            RCC_PROBE_RETURN(RCC_OP_GET_SYSCLK, RCC_HSE_FREQ);
+        default:
+            break;  // PLLP or PLLR
+    }
+
+    PLLCFGR = RCC_READ(RCC->PLLCFGR);
+    InFreq = ((PLLCFGR >> 22) & 1) ? RCC_HSE_FREQ : RCC_HSI_FREQ;
+    M = PLLCFGR & 0x3F;
+    if (Sws == SYSPLLP) {
+        Div = (((PLLCFGR >> 16) & 0x3) + 1) * 2;   // PLLP: 2, 4, 6, 8
+    } else {
+        Div = (PLLCFGR >> 28) & 0x7;               // PLLR: 2..7
+    }
+    if (M < 2 || Div < 2) {
+        RCC_PROBE_RETURN(RCC_OP_GET_SYSCLK, 0);  // Invalid factors
+    }
 
-    return 0;  // Success
+    Freq = (uint32_t)((unsigned long long)InFreq * ((PLLCFGR >> 6) & 0x1FF) / M / Div);
+    RCC_PROBE_RETURN(RCC_OP_GET_SYSCLK, Freq);
 }
 
 /**
@@ -66,81 +259,434 @@ uint8_t RCC_SetSysClk(SYS_CLK_t SYSClkType) {
  * @return uint8_t Returns 0 if the mode is set successfully, 1 for an invalid input.
  */
 uint8_t RCC_HSE_Mode(HSE_t HSE_MODE) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (HSE_MODE == BYPASSED) {
-        RCC->CR |= (1 << 18);  // Set HSEBYP bit to bypass HSE with external clock signal
-        return 0;             // Success
+        Old = RCC_READ(RCC->CR);
+        RCC_WRITE(RCC->CR, Old | (1 << 18));  // Set HSEBYP bit to bypass HSE with external clock signal
+        RCC_TRACE_EVENT(RCC_OP_HSE_MODE, HSE_MODE, CR, Old, Old | (1 << 18));
+        RCC_PROBE_RETURN(RCC_OP_HSE_MODE, 0);  // Success
     } else if (HSE_MODE == NOT_BYPASSED) {
-        RCC->CR &= ~(1 << 18); // Clear HSEBYP bit to use the HSE oscillator directly
-        return 0;             // Success
+        Old = RCC_READ(RCC->CR);
+        RCC_WRITE(RCC->CR, Old & ~(1 << 18)); // Clear HSEBYP bit to use the HSE oscillator directly
+        RCC_TRACE_EVENT(RCC_OP_HSE_MODE, HSE_MODE, CR, Old, Old & ~(1 << 18));
+        RCC_PROBE_RETURN(RCC_OP_HSE_MODE, 0);  // Success
     } else {
-        return 1;             // Invalid mode input
+        RCC_PROBE_RETURN(RCC_OP_HSE_MODE, 1);  // Invalid mode input
+    }
+}
+
+/**
+ * @brief Stops the main PLL unless it drives SYSCLK and waits for PLLRDY to clear.
+ */
+static uint8_t RCC_PLL_Stop(void) {
+    // The PLL cannot be stopped while it is the system clock
+    if (((RCC_READ(RCC->CFGR) >> 2) & 0b11) >= SYSPLLP) {
+        return 1;
+    }
+
+    // Disable PLL by clearing the PLLON bit
+    RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~(1 << 24));
+    if (RCC_WaitFor(&RCC->CR, 1 << 25, 0, RCC_WAIT_PLL_UNLOCK, 1)) {  // Wait until PLLRDY bit is cleared
+        return 1;  // PLL did not stop
     }
+    return 0;
+}
+
+/**
+ * @brief Starts the main PLL and waits for lock; on a timeout the PLL is left off.
+ */
+static uint8_t RCC_PLL_Start(void) {
+    // Enable PLL
+    RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) | (1 << 24));
+    if (RCC_WaitFor(&RCC->CR, 1 << 25, 1 << 25, RCC_WAIT_PLL_LOCK, 1)) {  // Wait until PLLRDY bit is set
+        RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~(1 << 24));  // Leave the PLL off rather than half-started
+        return 1;  // PLL did not lock
+    }
+    return 0;
+}
+
+/**
+ * @brief Reprograms PLLCFGR with the PLL stopped: one read and one store of PLLCFGR.
+ *
+ * The PLL is switched off, the fields in Mask are replaced by Bits in a single
+ * read-modify-write, then the PLL is restarted and its lock awaited.
+ *
+ * @return uint8_t Returns 0 on success, 1 if the PLL drives SYSCLK or failed to stop or lock.
+ */
+static uint8_t RCC_PLL_Program(RCC_OP_t Op, uint32_t Arg, uint32_t Mask, uint32_t Bits) {
+    uint32_t Old;
+
+    (void)Op;   // Only recorded when RCC_TRACE is enabled
+    (void)Arg;
+
+    if (RCC_PLL_Stop()) {
+        return 1;
+    }
+
+    // Every field in a single store, the reserved bits keep their value
+    Old = RCC_READ(RCC->PLLCFGR);
+    RCC_WRITE(RCC->PLLCFGR, (Old & ~Mask) | Bits);
+    RCC_TRACE_EVENT(Op, Arg, PLLCFGR, Old, (Old & ~Mask) | Bits);
+
+    return RCC_PLL_Start();
 }
 
 /**
  * @brief Configures the Phase-Locked Loop (PLL).
  *
- * This function sets the PLL configuration parameters including multipliers and dividers.
+ * Legacy interface: PLL_Division is used both as PLLM and as PLLP, and PLLQ/PLLR are
+ * left unchanged. New code should use RCC_PLL_SetConfig(), which sets every factor.
  *
  * @param PLL_Multiplexer The PLL multiplier value.
  * @param Src The clock source type for PLL (HSI or HSE).
- * @return uint8_t Returns 0 on success, 1 if an error occurs.
+ * @return uint8_t Returns 0 on success, 1 for invalid parameters (including a VCO input
+ *         or output out of range) or if the PLL did not lock in time.
  */
 uint8_t RCC_PLL_Config(uint32_t PLL_Multiplexer,uint8_t PLL_Division ,CLK_t Src) {
-	// Disable PLL by clearing the PLLON bit
-	    RCC->CR &= ~(1 << 24);
-	    while ((RCC->CR >> 25) & 1);  // Wait until PLLRDY bit is cleared
-
-	    // Select the clock source for PLL
-	    if (Src == HSI) {
-	        RCC->PLLCFGR &= ~(1 << 22); // HSI clock selected as PLL source
-	    } else if (Src == HSE) {
-	        RCC->PLLCFGR |= (1 << 22);  // HSE oscillator clock selected as PLL source
-	    } else {
-	        return 1;  // Invalid clock source
+	    uint8_t Result;
+	    RCC_PROBE_ENTRY();
+
+	    // Validate every parameter before the running PLL is touched
+	    if (Src != HSI && Src != HSE) {
+	        RCC_PROBE_RETURN(RCC_OP_PLL_CONFIG, 1);  // Invalid clock source
 	    }
 
-	    // Validate and set the PLL multiplier (PLLN)
+	    // Validate the PLL multiplier (PLLN)
 	    if (PLL_Multiplexer < 50 || PLL_Multiplexer > 432) {
-	        return 1;  // Invalid PLL multiplier value
+	        RCC_PROBE_RETURN(RCC_OP_PLL_CONFIG, 1);  // Invalid PLL multiplier value
 	    }
 
-	    // Validate and set the PLL prescaler (PLLM)
-	    if (PLL_Division < 2 || PLL_Division > 63) {
-	        return 1;  // Invalid PLLM value
+	    // PLL_Division doubles as PLLP, so only 2, 4, 6 and 8 are accepted
+	    if (PLL_Division != 2 && PLL_Division != 4 && PLL_Division != 6 && PLL_Division != 8) {
+	        RCC_PROBE_RETURN(RCC_OP_PLL_CONFIG, 1);  // Invalid PLLP divider value
 	    }
 
-	    // Clear PLLM and PLLN bits
-	    RCC->PLLCFGR &= ~(0x3F << 0);  // Clear PLLM bits (PLLM[5:0])
-	    RCC->PLLCFGR &= ~(0x1FF << 6); // Clear PLLN bits (PLLN[8:0])
-
-	    // Set PLLM and PLLN to desired values
-	    RCC->PLLCFGR |= (PLL_Division << 0);    // Set PLLM to desired value
-	    RCC->PLLCFGR |= (PLL_Multiplexer << 6); // Set PLLN to desired value
-
-	    // Configure PLLP divider (PLLP[1:0]) for output clock
-	    switch (PLL_Division) {
-	        case 2:
-	            RCC->PLLCFGR &= ~(0x3 << 16); // Clear PLLP and set it to 2
-	            break;
-	        case 4:
-	            RCC->PLLCFGR = (RCC->PLLCFGR & ~(0x3 << 16)) | (1 << 16); // Set PLLP to 4
-	            break;
-	        case 6:
-	            RCC->PLLCFGR = (RCC->PLLCFGR & ~(0x3 << 16)) | (2 << 16); // Set PLLP to 6
-	            break;
-	        case 8:
-	            RCC->PLLCFGR = (RCC->PLLCFGR & ~(0x3 << 16)) | (3 << 16); // Set PLLP to 8
-	            break;
-	        default:
-	            return 1;  // Invalid PLLP divider value
+	    // PLL_Division is also PLLM: the VCO input and output must stay in range
+	    if (RCC_CFG_CHECK_PLL(RCC_HSE_FREQ, Src, PLL_Division, PLL_Multiplexer, PLL_Division, 2, 2, SYSPLLP, 0) &
+	        (RCC_CFG_ERR_VCO_IN | RCC_CFG_ERR_VCO_OUT)) {
+	        RCC_PROBE_RETURN(RCC_OP_PLL_CONFIG, 1);  // VCO out of range, the PLL is left untouched
 	    }
 
-	    // Enable PLL
-	    RCC->CR |= (1 << 24);
-	    while (!((RCC->CR >> 25) & 1));  // Wait until PLLRDY bit is set
+	    Result = RCC_PLL_Program(RCC_OP_PLL_CONFIG, Src,
+	                             (0x3FUL << 0) | (0x1FFUL << 6) | (0x3UL << 16) | (1UL << 22),
+	                             ((uint32_t)PLL_Division << 0) | (PLL_Multiplexer << 6) |
+	                             ((uint32_t)(PLL_Division / 2 - 1) << 16) | ((Src == HSE) ? (1UL << 22) : 0));
+
+	    RCC_PROBE_RETURN(RCC_OP_PLL_CONFIG, Result);
+}
+
+/**
+ * @brief Programs every factor of the main PLL and its input source.
+ *
+ * PLLCFGR is written with exactly one read and one store while the PLL is stopped,
+ * then the PLL is restarted and its lock awaited. The VCO input (1..2 MHz) and
+ * output (100..432 MHz) are checked against RCC_HSE_FREQ / RCC_HSI_FREQ before the PLL
+ * is stopped; the SYSCLK and bus limits are not, see RCC_CheckClkConfig().
+ *
+ * @param Config M (2..63), N (50..432), P (2, 4, 6, 8), Q (2..15), R (2..7) and
+ *               source (HSI or HSE).
+ * @return uint8_t Returns 0 on success, 1 for an invalid factor or VCO frequency, when
+ *         the PLL drives SYSCLK or if it did not lock in time.
+ */
+uint8_t RCC_PLL_SetConfig(const PLL_CONFIG_t *Config) {
+    uint8_t Result;
+    RCC_PROBE_ENTRY();
+
+    if (Config == 0) {
+        RCC_PROBE_RETURN(RCC_OP_PLL_SET_CONFIG, 1);
+    }
+    if ((Config->PLL_Src != HSI && Config->PLL_Src != HSE) ||
+        Config->PLL_M < 2 || Config->PLL_M > 63 ||
+        Config->PLL_N < 50 || Config->PLL_N > 432 ||
+        !RCC_IS_PLLP_DIV(Config->PLL_P) ||
+        Config->PLL_Q < 2 || Config->PLL_Q > 15 ||
+        Config->PLL_R < 2 || Config->PLL_R > 7) {
+        RCC_PROBE_RETURN(RCC_OP_PLL_SET_CONFIG, 1);  // Factor out of range, the PLL is left untouched
+    }
+    if (RCC_CFG_CHECK_PLL(RCC_HSE_FREQ, Config->PLL_Src, Config->PLL_M, Config->PLL_N, Config->PLL_P,
+                          Config->PLL_Q, Config->PLL_R, SYSPLLP, 0) & (RCC_CFG_ERR_VCO_IN | RCC_CFG_ERR_VCO_OUT)) {
+        RCC_PROBE_RETURN(RCC_OP_PLL_SET_CONFIG, 1);  // VCO input or output out of range for RCC_HSE_FREQ / RCC_HSI_FREQ
+    }
+
+    Result = RCC_PLL_Program(RCC_OP_PLL_SET_CONFIG, Config->PLL_Src,
+                             (0x3FUL << 0) | (0x1FFUL << 6) | (0x3UL << 16) | (1UL << 22) | (0xFUL << 24) | (0x7UL << 28),
+                             ((uint32_t)Config->PLL_M << 0) | ((uint32_t)Config->PLL_N << 6) |
+                             ((uint32_t)(Config->PLL_P / 2 - 1) << 16) |
+                             ((Config->PLL_Src == HSE) ? (1UL << 22) : 0) |
+                             ((uint32_t)Config->PLL_Q << 24) | ((uint32_t)Config->PLL_R << 28));
+
+    RCC_PROBE_RETURN(RCC_OP_PLL_SET_CONFIG, Result);
+}
+
+/**
+ * @brief Picks the PLL output that gives the highest legal system clock.
+ *
+ * PLLP only offers /2, /4, /6, /8 while PLLR offers every divider from 2 to 7, so for
+ * a given crystal and VCO the R output can land closer to the 180 MHz ceiling, and
+ * the other output stays free for a second rate. On a tie PLLP is kept.
+ *
+ * @param Config The PLL factors (source, M, N, P and R are used).
+ * @param HSE_Freq HSE frequency in Hz, used when the PLL source is HSE.
+ * @param Output Receives SYSPLLP or SYSPLLR.
+ * @return uint8_t Returns 0 on success, 1 if the source, M (2..63), N (50..432) or the
+ *         VCO input or output is out of range, neither output is legal or a pointer is
+ *         invalid.
+ */
+uint8_t RCC_PLL_SelectSysOutput(const PLL_CONFIG_t *Config, uint32_t HSE_Freq, SYS_CLK_t *Output) {
+    unsigned long long Vco;
+    unsigned long long FreqP = 0;
+    unsigned long long FreqR = 0;
+    RCC_PROBE_ENTRY();
+
+    if (Config == 0 || Output == 0) {
+        RCC_PROBE_RETURN(RCC_OP_PLL_SELECT, 1);
+    }
+
+    if ((Config->PLL_Src != HSI && Config->PLL_Src != HSE) ||
+        Config->PLL_M < 2 || Config->PLL_M > 63 ||
+        Config->PLL_N < 50 || Config->PLL_N > 432) {
+        RCC_PROBE_RETURN(RCC_OP_PLL_SELECT, 1);  // Source, M or N out of range
+    }
+    if (RCC_CFG_CHECK_PLL(HSE_Freq, Config->PLL_Src, Config->PLL_M, Config->PLL_N, Config->PLL_P,
+                          Config->PLL_Q, Config->PLL_R, SYSPLLP, 0) & (RCC_CFG_ERR_VCO_IN | RCC_CFG_ERR_VCO_OUT)) {
+        RCC_PROBE_RETURN(RCC_OP_PLL_SELECT, 1);  // VCO input or output out of range, no output is usable
+    }
+
+    Vco = RCC_VCO_OUT_FREQ(HSE_Freq, Config->PLL_Src, Config->PLL_M, Config->PLL_N);
+
+    if (RCC_IS_PLLP_DIV(Config->PLL_P) && Vco / Config->PLL_P <= RCC_SYSCLK_MAX_FREQ) {
+        FreqP = Vco / Config->PLL_P;
+    }
+    if (Config->PLL_R >= 2 && Config->PLL_R <= 7 && Vco / Config->PLL_R <= RCC_SYSCLK_MAX_FREQ) {
+        FreqR = Vco / Config->PLL_R;
+    }
+
+    if (FreqP == 0 && FreqR == 0) {
+        RCC_PROBE_RETURN(RCC_OP_PLL_SELECT, 1);  // Both outputs above the SYSCLK limit or invalid
+    }
+    *Output = (FreqR > FreqP) ? SYSPLLR : SYSPLLP;
+    RCC_PROBE_RETURN(RCC_OP_PLL_SELECT, 0);
+}
+
+/**
+ * @brief Routes a SAI or I2S kernel clock to the main PLL R output.
+ *
+ * The kernel source fields of DCKCFGR all encode the main PLL R output as 0b10;
+ * OFF puts the field back to its reset source (PLLSAI for SAI, PLLI2S for I2S).
+ *
+ * @param Kernel The kernel to route (PLLR_SAI1, PLLR_SAI2, PLLR_I2S1, PLLR_I2S2).
+ * @param Status ON to clock the kernel from PLLR, OFF to restore the reset source.
+ * @return uint8_t Returns 0 on success, 1 for an invalid kernel or status.
+ */
+uint8_t RCC_PLLR_RouteKernel(RCC_PLLR_KERNEL_t Kernel, STATUS_t Status) {
+    uint32_t Old;
+    uint32_t New;
+    RCC_PROBE_ENTRY();
+
+    if ((Kernel != PLLR_SAI1 && Kernel != PLLR_SAI2 && Kernel != PLLR_I2S1 && Kernel != PLLR_I2S2) ||
+        (Status != ON && Status != OFF)) {
+        RCC_PROBE_RETURN(RCC_OP_PLLR_KERNEL, 1);
+    }
+
+    Old = RCC_READ(RCC->DCKCFGR);
+    New = (Old & ~(0b11UL << Kernel)) | ((Status == ON) ? (0b10UL << Kernel) : 0);
+    RCC_WRITE(RCC->DCKCFGR, New);
+    RCC_TRACE_EVENT(RCC_OP_PLLR_KERNEL, Kernel, DCKCFGR, Old, New);
+
+    RCC_PROBE_RETURN(RCC_OP_PLLR_KERNEL, 0);  // Success
+}
+
+/**
+ * @brief Checks a full clock configuration against the STM32F446 datasheet limits.
+ *
+ * No register is accessed, so the check can run before any clock is reconfigured.
+ * The same rules are available at compile time through RCC_CFG_CHECK().
+ *
+ * @param Config The clock configuration to check.
+ * @return uint32_t Bitmask of violated RCC_CFG_ERR_t constraints, 0 if the configuration is legal.
+ */
+uint32_t RCC_CheckClkConfig(const RCC_CLK_CONFIG_t *Config) {
+    uint32_t Errors;
+    RCC_PROBE_ENTRY();
+
+    if (Config == 0) {
+        RCC_PROBE_RETURN(RCC_OP_CHECK_CONFIG, RCC_CFG_ERR_NULL_PTR);  // Nothing to check
+    }
+
+    Errors = (uint32_t)RCC_CFG_CHECK(Config->HSE_Freq, Config->HSE_Mode, Config->PLL.PLL_Src,
+                                   Config->PLL.PLL_M, Config->PLL.PLL_N, Config->PLL.PLL_P,
+                                   Config->PLL.PLL_Q, Config->PLL.PLL_R, Config->SysClk,
+                                   Config->AHB_Div, Config->APB1_Div, Config->APB2_Div,
+                                   Config->Use48MHz);
+    RCC_PROBE_RETURN(RCC_OP_CHECK_CONFIG, Errors);
+}
+
+/**
+ * @brief Applies a clock register image (shared by RCC_LoadImage and RCC_EarlyInit).
+ *
+ * Every register is written with a single full-word store in the order the hardware
+ * requires: oscillators, PLL and kernel muxes, PLL start, over-drive, flash latency,
+ * CFGR switch and finally the peripheral enables. With Early set the bus enables are
+ * left alone and no probe is recorded, so nothing but the stack and the peripherals is
+ * touched and the sequence is safe before .data/.bss initialization.
+ *
+ * A main PLL that already runs with Image->PLLCFGR (restarted after Stop) is kept:
+ * PLLCFGR is not rewritten and only the over-drive, flash latency, switch and bus
+ * enable tail is applied. A PLL running with other factors is left alone (error).
+ *
+ * Every ready-wait is bounded by RCC_READY_TIMEOUT. On a timeout the failing source is
+ * switched off again and the core is left running from HSI.
+ *
+ * @return uint8_t Returns 0 on success, 1 if the PLL runs with other factors or a
+ *         ready flag timed out.
+ */
+static inline uint8_t RCC_ApplyImage(const RCC_IMAGE_t *Image, uint8_t Early) {
+    uint32_t Osc;
+    uint32_t PllOn = (RCC_READ(RCC->CR) >> 24) & 1;
+
+    // PLLCFGR must not be written while PLLON is set, even with the same value
+    if (PllOn && (!(Image->CR & (1 << 24)) || RCC_READ(RCC->PLLCFGR) != Image->PLLCFGR)) {
+        return 1;
+    }
+
+    // Start HSE first (HSEBYP must be set while HSE is still off)
+    Osc = Image->CR & ((1 << 16) | (1 << 18));
+    if (Osc & (1 << 18)) {
+        RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) | (1 << 18));
+    }
+    if (Osc & (1 << 16)) {
+        RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) | (1 << 16));
+        if (RCC_WaitFor(&RCC->CR, 1 << 17, 1 << 17, RCC_WAIT_HSE_READY, !Early)) {  // Wait until HSERDY bit is set
+            RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~((1 << 16) | (1 << 18)));  // Stay on HSI
+            return 1;
+        }
+    }
+
+    // PLL factors and kernel clock muxes while the PLL is still off
+    if (!PllOn) {
+        RCC_WRITE(RCC->PLLCFGR, Image->PLLCFGR);
+    }
+    RCC_WRITE(RCC->DCKCFGR, Image->DCKCFGR);
+    RCC_WRITE(RCC->DCKCFGR2, Image->DCKCFGR2);
+
+    if ((Image->CR & (1 << 24)) && !PllOn) {
+        RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) | (1 << 24));  // Start the PLL, lock is awaited after the flash setup
+    }
+
+    // Over-drive is entered once the PLL is enabled (RM0390 5.1.4)
+    if (Image->OverDrive) {
+        RCC_WRITE(RCC->APB1ENR, RCC_READ(RCC->APB1ENR) | (1 << 28));                        // PWREN only, the image enables come last
+        RCC_WRITE(PWR->CR, RCC_READ(PWR->CR) | (1 << 16));                                  // ODEN
+        if (RCC_WaitFor(&PWR->CSR, 1 << 16, 1 << 16, RCC_WAIT_OVERDRIVE, !Early)) {         // Wait until ODRDY bit is set
+            RCC_WRITE(PWR->CR, RCC_READ(PWR->CR) & ~(1 << 16));
+            RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~((1 << 24) | (1 << 16) | (1 << 18)));
+            return 1;
+        }
+        RCC_WRITE(PWR->CR, RCC_READ(PWR->CR) | (1 << 17));                                  // ODSWEN
+        if (RCC_WaitFor(&PWR->CSR, 1 << 17, 1 << 17, RCC_WAIT_OVERDRIVE, !Early)) {         // Wait until ODSWRDY bit is set
+            RCC_WRITE(PWR->CR, RCC_READ(PWR->CR) & ~((1 << 16) | (1 << 17)));
+            RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~((1 << 24) | (1 << 16) | (1 << 18)));
+            return 1;
+        }
+    }
+
+    // Raise the flash latency before the faster clock is selected
+    RCC_WRITE(FLASH->ACR, Image->FLASH_ACR);
+    if (RCC_WaitFor(&FLASH->ACR, 0xF, Image->FLASH_ACR & 0xF, RCC_WAIT_FLASH_LATENCY, !Early)) {
+        RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~((1 << 24) | (1 << 16) | (1 << 18)));
+        return 1;
+    }
+
+    if (Image->CR & (1 << 24)) {
+        if (RCC_WaitFor(&RCC->CR, 1 << 25, 1 << 25, RCC_WAIT_PLL_LOCK, !Early)) {  // Wait until PLLRDY bit is set
+            RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~((1 << 24) | (1 << 16) | (1 << 18)));
+            return 1;
+        }
+    }
+
+    // Prescalers and system clock switch in a single store
+    RCC_WRITE(RCC->CFGR, Image->CFGR);
+    if (RCC_WaitFor(&RCC->CFGR, 0b11 << 2, (Image->CFGR & 0b11) << 2, RCC_WAIT_SYSCLK_SWITCH, !Early)) {
+        RCC_WRITE(RCC->CFGR, Image->CFGR & ~0b11UL);  // Fall back to HSI, keep the prescalers
+        RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~((1 << 24) | (1 << 16) | (1 << 18)));
+        return 1;
+    }
+
+    if (!Early) {
+        RCC_WRITE(RCC->AHB1ENR, Image->AHB1ENR);
+        RCC_WRITE(RCC->AHB2ENR, Image->AHB2ENR);
+        RCC_WRITE(RCC->AHB3ENR, Image->AHB3ENR);
+        RCC_WRITE(RCC->APB1ENR, Image->APB1ENR);
+        RCC_WRITE(RCC->APB2ENR, Image->APB2ENR);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Applies a precomputed clock register image in one pass.
+ *
+ * Must be called from the reset clock state (HSI system clock, PLL off) or with the
+ * PLL already locked on Image->PLLCFGR, as after RCC_SetClkStatus(PLL, ON) on a Stop
+ * wake-up; PLLCFGR is then not rewritten. The bus enable registers are overwritten.
+ *
+ * @param Image The register image, typically generated by Tools/RCC_clkgen.
+ * @return uint8_t Returns 0 on success, 1 if the image pointer is invalid, the PLL runs
+ *         with other factors (nothing is changed) or a clock failed to become ready
+ *         (the core is then left running from HSI).
+ */
+uint8_t RCC_LoadImage(const RCC_IMAGE_t *Image) {
+    RCC_PROBE_ENTRY();
+
+    if (Image == 0) {
+        RCC_PROBE_RETURN(RCC_OP_LOAD_IMAGE, 1);  // No image
+    }
+
+    RCC_TRACE_SNAPSHOT(OldPLLCFGR, RCC_READ(RCC->PLLCFGR));
+    RCC_TRACE_SNAPSHOT(OldCFGR, RCC_READ(RCC->CFGR));
+
+    if (RCC_ApplyImage(Image, 0)) {
+        RCC_ClockChanged();
+        // Arg 1: what the registers were left at after the failover, not the image
+        RCC_TRACE_EVENT(RCC_OP_LOAD_IMAGE, 1, PLLCFGR, OldPLLCFGR, RCC_READ(RCC->PLLCFGR));
+        RCC_TRACE_EVENT(RCC_OP_LOAD_IMAGE, 1, CFGR, OldCFGR, RCC_READ(RCC->CFGR));
+        RCC_PROBE_RETURN(RCC_OP_LOAD_IMAGE, 1);  // Timed out, failed over to HSI
+    }
+    RCC_ClockChanged();
+
+    RCC_TRACE_EVENT(RCC_OP_LOAD_IMAGE, 0, PLLCFGR, OldPLLCFGR, Image->PLLCFGR);
+    RCC_TRACE_EVENT(RCC_OP_LOAD_IMAGE, 0, CFGR, OldCFGR, Image->CFGR);
+
+    RCC_PROBE_RETURN(RCC_OP_LOAD_IMAGE, 0);  // Success
+}
+
+/**
+ * @brief Raises the clock tree to the RCC_EARLY_* image straight out of reset.
+ *
+ * Safe to call first in SystemInit / Reset_Handler, before .data is copied and .bss
+ * is zeroed: it reads no initialized data and writes no globals. The image itself is
+ * a const object placed in flash. With RCC_INSTRUMENTATION its probe record lands in
+ * RCC_Stats and is cleared again by the .bss initialization that follows.
+ *
+ * @return uint8_t Returns 0 on success, 1 if a clock failed to become ready in time
+ *         (the core is then left running from HSI).
+ */
+uint8_t RCC_EarlyInit(void) {
+    static const RCC_IMAGE_t EarlyImage = {
+        RCC_EARLY_CR, RCC_EARLY_PLLCFGR, RCC_EARLY_CFGR, 0, 0,
+        0, 0, 0, 0, 0,
+        RCC_EARLY_FLASH_ACR, RCC_EARLY_OVERDRIVE
+    };
+    uint8_t Result;
+#if RCC_INSTRUMENTATION
+    RCC_CycleCounterStart();  // Still off straight out of reset
+#endif
+    RCC_PROBE_ENTRY();
 
-	    return 0;  // Success
+    Result = RCC_ApplyImage(&EarlyImage, 1);  // Peripheral enables are left at their reset values
+    RCC_PROBE_RETURN(RCC_OP_EARLY_INIT, Result);
 }
 
 /**
@@ -150,12 +696,17 @@ uint8_t RCC_PLL_Config(uint32_t PLL_Multiplexer,uint8_t PLL_Division ,CLK_t Src)
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_AHB1_EnableClk(RCC_AHB1_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_AHB1_ENABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->AHB1ENR |= (1 << PeripheralName);  // Enable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->AHB1ENR);
+    RCC_WRITE(RCC->AHB1ENR, Old | (1 << PeripheralName));  // Enable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_AHB1_ENABLE, PeripheralName, AHB1ENR, Old, Old | (1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_AHB1_ENABLE, 0);  // Success
 }
 
 /**
@@ -165,12 +716,17 @@ uint8_t RCC_AHB1_EnableClk(RCC_AHB1_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_AHB1_DisableClk(RCC_AHB1_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_AHB1_DISABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->AHB1ENR &= ~(1 << PeripheralName);  // Disable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->AHB1ENR);
+    RCC_WRITE(RCC->AHB1ENR, Old & ~(1 << PeripheralName));  // Disable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_AHB1_DISABLE, PeripheralName, AHB1ENR, Old, Old & ~(1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_AHB1_DISABLE, 0);  // Success
 }
 
 /**
@@ -180,12 +736,17 @@ uint8_t RCC_AHB1_DisableClk(RCC_AHB1_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_AHB2_EnableClk(RCC_AHB2_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_AHB2_ENABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->AHB2ENR |= (1 << PeripheralName);  // Enable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->AHB2ENR);
+    RCC_WRITE(RCC->AHB2ENR, Old | (1 << PeripheralName));  // Enable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_AHB2_ENABLE, PeripheralName, AHB2ENR, Old, Old | (1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_AHB2_ENABLE, 0);  // Success
 }
 
 /**
@@ -195,12 +756,17 @@ uint8_t RCC_AHB2_EnableClk(RCC_AHB2_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_AHB2_DisableClk(RCC_AHB2_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_AHB2_DISABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->AHB2ENR &= ~(1 << PeripheralName);  // Disable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->AHB2ENR);
+    RCC_WRITE(RCC->AHB2ENR, Old & ~(1 << PeripheralName));  // Disable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_AHB2_DISABLE, PeripheralName, AHB2ENR, Old, Old & ~(1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_AHB2_DISABLE, 0);  // Success
 }
 
 /**
@@ -210,12 +776,17 @@ uint8_t RCC_AHB2_DisableClk(RCC_AHB2_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_AHB3_EnableClk(RCC_AHB3_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_AHB3_ENABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->AHB3ENR |= (1 << PeripheralName);  // Enable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->AHB3ENR);
+    RCC_WRITE(RCC->AHB3ENR, Old | (1 << PeripheralName));  // Enable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_AHB3_ENABLE, PeripheralName, AHB3ENR, Old, Old | (1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_AHB3_ENABLE, 0);  // Success
 }
 
 /**
@@ -225,12 +796,17 @@ uint8_t RCC_AHB3_EnableClk(RCC_AHB3_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_AHB3_DisableClk(RCC_AHB3_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_AHB3_DISABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->AHB3ENR &= ~(1 << PeripheralName);  // Disable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->AHB3ENR);
+    RCC_WRITE(RCC->AHB3ENR, Old & ~(1 << PeripheralName));  // Disable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_AHB3_DISABLE, PeripheralName, AHB3ENR, Old, Old & ~(1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_AHB3_DISABLE, 0);  // Success
 }
 
 /**
@@ -240,12 +816,17 @@ uint8_t RCC_AHB3_DisableClk(RCC_AHB3_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_APB1_EnableClk(RCC_APB1_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_APB1_ENABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->APB1ENR |= (1 << PeripheralName);  // Enable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->APB1ENR);
+    RCC_WRITE(RCC->APB1ENR, Old | (1 << PeripheralName));  // Enable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_APB1_ENABLE, PeripheralName, APB1ENR, Old, Old | (1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_APB1_ENABLE, 0);  // Success
 }
 
 /**
@@ -255,12 +836,17 @@ uint8_t RCC_APB1_EnableClk(RCC_APB1_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_APB1_DisableClk(RCC_APB1_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_APB1_DISABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->APB1ENR &= ~(1 << PeripheralName);  // Disable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->APB1ENR);
+    RCC_WRITE(RCC->APB1ENR, Old & ~(1 << PeripheralName));  // Disable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_APB1_DISABLE, PeripheralName, APB1ENR, Old, Old & ~(1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_APB1_DISABLE, 0);  // Success
 }
 
 /**
@@ -270,12 +856,17 @@ uint8_t RCC_APB1_DisableClk(RCC_APB1_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_APB2_EnableClk(RCC_APB2_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_APB2_ENABLE, 1);  // Return error if the peripheral name is out of range
     }
 
-    RCC->APB2ENR |= (1 << PeripheralName);  // Enable the peripheral clock
-    return 0;  // Success
+    Old = RCC_READ(RCC->APB2ENR);
+    RCC_WRITE(RCC->APB2ENR, Old | (1 << PeripheralName));  // Enable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_APB2_ENABLE, PeripheralName, APB2ENR, Old, Old | (1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_APB2_ENABLE, 0);  // Success
 }
 
 /**
@@ -285,10 +876,1428 @@ uint8_t RCC_APB2_EnableClk(RCC_APB2_PERIPHERAL_t PeripheralName) {
  * @return uint8_t Returns 0 on success, 1 if the peripheral name is invalid.
  */
 uint8_t RCC_APB2_DisableClk(RCC_APB2_PERIPHERAL_t PeripheralName) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
     if (PeripheralName > 31) {
-        return 1;  // Return error if the peripheral name is out of range
+        RCC_PROBE_RETURN(RCC_OP_APB2_DISABLE, 1);  // Return error if the peripheral name is out of range
+    }
+
+    Old = RCC_READ(RCC->APB2ENR);
+    RCC_WRITE(RCC->APB2ENR, Old & ~(1 << PeripheralName));  // Disable the peripheral clock
+    RCC_TRACE_EVENT(RCC_OP_APB2_DISABLE, PeripheralName, APB2ENR, Old, Old & ~(1 << PeripheralName));
+    RCC_PROBE_RETURN(RCC_OP_APB2_DISABLE, 0);  // Success
+}
+
+/**
+ * @brief Enables or disables the clock security system on HSE.
+ *
+ * @param Status ON to monitor HSE and fall back to HSI on failure, OFF to stop monitoring.
+ * @return uint8_t Returns 0 on success, 1 for an invalid status.
+ */
+uint8_t RCC_SetCSSStatus(STATUS_t Status) {
+    uint32_t Old;
+    uint32_t New;
+    RCC_PROBE_ENTRY();
+
+    if (Status != ON && Status != OFF) {
+        RCC_PROBE_RETURN(RCC_OP_CSS_STATUS, 1);  // Invalid status
+    }
+
+    Old = RCC_READ(RCC->CR);
+    New = (Status == ON) ? (Old | (1 << 19)) : (Old & ~(1 << 19));  // CSSON
+    RCC_WRITE(RCC->CR, New);
+    RCC_TRACE_EVENT(RCC_OP_CSS_STATUS, Status, CR, Old, New);
+
+    RCC_PROBE_RETURN(RCC_OP_CSS_STATUS, 0);  // Success
+}
+
+/**
+ * @brief Handles a clock security system event; call it from NMI_Handler.
+ *
+ * On an HSE failure the hardware has already switched SYSCLK to HSI and stopped HSE
+ * (and the PLL when it runs from HSE). This clears the CSS flag and records the event.
+ *
+ * @return uint8_t Returns 0 if a CSS event was handled, 1 if CSS was not the NMI source.
+ */
+uint8_t RCC_CSS_IRQHandler(void) {
+    uint32_t Flags;
+    RCC_PROBE_ENTRY();
+
+    Flags = RCC_READ(RCC->CIR);
+    if (((Flags >> 7) & 1) == 0) {
+        RCC_PROBE_RETURN(RCC_OP_CSS_EVENT, 1);  // CSSF not set: the NMI came from another source
+    }
+
+    RCC_WRITE(RCC->CIR, Flags | (1 << 23));  // CSSC: clear the CSS flag
+    RCC_TRACE_EVENT(RCC_OP_CSS_EVENT, 0, CIR, Flags, Flags | (1 << 23));
+    RCC_ClockChanged();  // Now on HSI
+
+    RCC_PROBE_RETURN(RCC_OP_CSS_EVENT, 0);  // CSS event handled
+}
+
+// volatile: stored before LSERDYIE is enabled and read back in RCC_IRQHandler
+static RCC_CALLBACK_t volatile RCC_LSE_Callback;  // Pending RCC_LSE_Start() completion
+
+// BDCR writes are silently dropped while DBP is clear
+#define RCC_BACKUP_LOCKED()     (((RCC_READ(PWR->CR) >> 8) & 1) == 0)
+
+/**
+ * @brief Enables or disables write access to the backup domain (BDCR, RTC, backup SRAM).
+ *
+ * Turns on the PWR interface clock and sets or clears DBP in PWR_CR. Access stays
+ * enabled until it is disabled again, so the LSE/RTC functions below can be called
+ * in sequence after a single RCC_BackupAccess(ON).
+ *
+ * @param Status ON to unlock the backup domain, OFF to protect it again.
+ * @return uint8_t Returns 0 on success, 1 for an invalid status or if DBP did not take effect.
+ */
+uint8_t RCC_BackupAccess(STATUS_t Status) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
+    if (Status != ON && Status != OFF) {
+        RCC_PROBE_RETURN(RCC_OP_BACKUP_ACCESS, 1);  // Invalid status
+    }
+
+    if (Status == ON) {
+        Old = RCC_READ(RCC->APB1ENR);
+        RCC_WRITE(RCC->APB1ENR, Old | (1 << PWREN));  // PWR interface clock
+        RCC_TRACE_EVENT(RCC_OP_BACKUP_ACCESS, Status, APB1ENR, Old, Old | (1 << PWREN));
+        RCC_WRITE(PWR->CR, RCC_READ(PWR->CR) | (1 << 8));   // DBP
+    } else {
+        RCC_WRITE(PWR->CR, RCC_READ(PWR->CR) & ~(1 << 8));
+    }
+
+    // The DBP write goes through the APB1 bridge; read it back before BDCR is touched
+    if (RCC_WaitFor(&PWR->CR, 1 << 8, (uint32_t)Status << 8, RCC_WAIT_OSC_READY, 0)) {
+        RCC_PROBE_RETURN(RCC_OP_BACKUP_ACCESS, 1);
+    }
+
+    RCC_PROBE_RETURN(RCC_OP_BACKUP_ACCESS, 0);  // Success
+}
+
+/**
+ * @brief Resets the whole backup domain (LSE, RTC clock selection, RTC and backup registers).
+ *
+ * This is the only way to change RTCSEL once it has been written. Requires backup
+ * domain access.
+ *
+ * @return uint8_t Returns 0 on success, 1 without backup domain access.
+ */
+uint8_t RCC_BackupReset(void) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
+    if (RCC_BACKUP_LOCKED()) {
+        RCC_PROBE_RETURN(RCC_OP_BACKUP_RESET, 1);  // RCC_BackupAccess(ON) first
+    }
+
+    Old = RCC_READ(RCC->BDCR);
+    RCC_WRITE(RCC->BDCR, Old | (1 << 16));    // BDRST: the whole domain returns to its reset state
+    RCC_WRITE(RCC->BDCR, 0);                  // Release the reset
+    RCC_TRACE_EVENT(RCC_OP_BACKUP_RESET, 0, BDCR, Old, 0);
+    RCC_LSE_Callback = 0;
+
+    RCC_PROBE_RETURN(RCC_OP_BACKUP_RESET, 0);  // Success
+}
+
+/**
+ * @brief Selects the LSE drive level or the external clock bypass.
+ *
+ * LSEMOD and LSEBYP can only change while LSE is off. Requires backup domain access.
+ *
+ * @param Mode LSE_LOW_DRIVE, LSE_HIGH_DRIVE or LSE_BYPASS.
+ * @return uint8_t Returns 0 on success, 1 for an invalid mode, if LSE is running or
+ *         without backup domain access.
+ */
+uint8_t RCC_LSE_SetMode(RCC_LSE_MODE_t Mode) {
+    uint32_t Old;
+    uint32_t New;
+    RCC_PROBE_ENTRY();
+
+    if ((unsigned)Mode > LSE_BYPASS || RCC_BACKUP_LOCKED()) {
+        RCC_PROBE_RETURN(RCC_OP_LSE_MODE, 1);  // Invalid mode or backup domain protected
+    }
+
+    Old = RCC_READ(RCC->BDCR);
+    if (Old & (1 << 0)) {
+        RCC_PROBE_RETURN(RCC_OP_LSE_MODE, 1);  // LSEON set: the mode is locked
+    }
+
+    New = Old & ~((1 << 2) | (1 << 3));
+    if (Mode == LSE_HIGH_DRIVE) {
+        New |= (1 << 3);   // LSEMOD
+    } else if (Mode == LSE_BYPASS) {
+        New |= (1 << 2);   // LSEBYP
+    }
+    RCC_WRITE(RCC->BDCR, New);
+    RCC_TRACE_EVENT(RCC_OP_LSE_MODE, Mode, BDCR, Old, New);
+
+    RCC_PROBE_RETURN(RCC_OP_LSE_MODE, 0);  // Success
+}
+
+/**
+ * @brief Starts LSE without waiting for it (start-up can take up to 2 s).
+ *
+ * With a callback the LSE ready interrupt is enabled and the callback runs from
+ * RCC_IRQHandler() once LSE is stable; with no callback the caller polls
+ * RCC_LSE_IsReady(). Requires backup domain access.
+ *
+ * @param Callback Function called from interrupt context when LSE is ready, or 0.
+ * @return uint8_t Returns 0 once LSE is starting (or already running), 1 without
+ *         backup domain access.
+ */
+uint8_t RCC_LSE_Start(RCC_CALLBACK_t Callback) {
+    uint32_t Old;
+    RCC_PROBE_ENTRY();
+
+    if (RCC_BACKUP_LOCKED()) {
+        RCC_PROBE_RETURN(RCC_OP_LSE_START, 1);  // RCC_BackupAccess(ON) first
     }
 
-    RCC->APB2ENR &= ~(1 << PeripheralName);  // Disable the peripheral clock
-    return 0;  // Success
+    RCC_LSE_Callback = Callback;
+    if (Callback != 0) {
+        // Enable LSERDYIE before LSEON so the ready flag cannot be missed
+        RCC_WRITE(RCC->CIR, (RCC_READ(RCC->CIR) & (0x7F << 8)) | (1 << 9) | (1 << 17));
+    }
+
+    Old = RCC_READ(RCC->BDCR);
+    RCC_WRITE(RCC->BDCR, Old | (1 << 0));     // LSEON
+    RCC_TRACE_EVENT(RCC_OP_LSE_START, Callback != 0, BDCR, Old, Old | (1 << 0));
+
+    RCC_PROBE_RETURN(RCC_OP_LSE_START, 0);  // Started
+}
+
+/**
+ * @brief Tells whether LSE is running and stable.
+ *
+ * @return uint8_t Returns 1 when LSERDY is set, 0 otherwise.
+ */
+uint8_t RCC_LSE_IsReady(void) {
+    uint8_t Ready;
+    RCC_PROBE_ENTRY();
+
+    Ready = (RCC_READ(RCC->BDCR) >> 1) & 1;  // LSERDY
+    RCC_PROBE_RETURN(RCC_OP_LSE_IS_READY, Ready);
+}
+
+/**
+ * @brief Handles the RCC global interrupt; install it as the RCC_IRQn vector.
+ *
+ * Acknowledges the LSE ready interrupt, disables it and runs the callback given to
+ * RCC_LSE_Start().
+ */
+void RCC_IRQHandler(void) {
+    uint32_t       Flags;
+    RCC_CALLBACK_t Callback;
+    RCC_PROBE_ENTRY();
+
+    Flags = RCC_READ(RCC->CIR);
+    if (Flags & (1 << 1)) {  // LSERDYF
+        // Clear the flag (LSERDYC) and disable LSERDYIE in a single store
+        RCC_WRITE(RCC->CIR, (Flags & (0x7F << 8) & ~(1 << 9)) | (1 << 17));
+        RCC_TRACE_EVENT(RCC_OP_LSE_READY, 0, CIR, Flags, (Flags & (0x7F << 8) & ~(1 << 9)) | (1 << 17));
+
+        Callback = RCC_LSE_Callback;
+        RCC_LSE_Callback = 0;
+        if (Callback != 0) {
+            Callback();
+        }
+    }
+    RCC_PROBE_EXIT(RCC_OP_LSE_READY);
+}
+
+/**
+ * @brief Selects the RTC clock source and enables the RTC clock.
+ *
+ * RTCSEL can be written only once after a backup domain reset; selecting a different
+ * source afterwards needs RCC_BackupReset(). The source does not have to be ready
+ * yet, so this can follow RCC_LSE_Start() immediately. Requires backup domain access.
+ *
+ * @param Src RTC_LSE, RTC_LSI or RTC_HSE.
+ * @param HSE_Div RTCPRE divider (2..31) giving 1 MHz from HSE; ignored for LSE/LSI.
+ * @return uint8_t Returns 0 on success, 1 for an invalid source or divider, if a
+ *         different source is already selected or without backup domain access.
+ */
+uint8_t RCC_RTC_Config(RCC_RTC_SRC_t Src, uint8_t HSE_Div) {
+    uint32_t Old;
+    uint32_t Sel;
+    uint32_t New;
+    RCC_PROBE_ENTRY();
+
+    if (Src == RTC_NO_CLK || (unsigned)Src > RTC_HSE) {
+        RCC_PROBE_RETURN(RCC_OP_RTC_CONFIG, 1);  // Invalid source
+    }
+    if (Src == RTC_HSE && (HSE_Div < 2 || HSE_Div > 31)) {
+        RCC_PROBE_RETURN(RCC_OP_RTC_CONFIG, 1);  // Invalid RTCPRE divider
+    }
+    if (RCC_BACKUP_LOCKED()) {
+        RCC_PROBE_RETURN(RCC_OP_RTC_CONFIG, 1);  // RCC_BackupAccess(ON) first
+    }
+
+    Old = RCC_READ(RCC->BDCR);
+    Sel = (Old >> 8) & 0x3;
+    if (Sel != RTC_NO_CLK && Sel != (uint32_t)Src) {
+        RCC_PROBE_RETURN(RCC_OP_RTC_CONFIG, 1);  // RTCSEL already written: backup domain reset needed
+    }
+
+    if (Src == RTC_HSE) {
+        // RTCPRE is in CFGR, outside the backup domain
+        RCC_WRITE(RCC->CFGR, (RCC_READ(RCC->CFGR) & ~(0x1F << 16)) | ((uint32_t)HSE_Div << 16));
+    }
+
+    New = (Old & ~(0x3 << 8)) | ((uint32_t)Src << 8) | (1 << 15);  // RTCSEL and RTCEN in one store
+    RCC_WRITE(RCC->BDCR, New);
+    RCC_TRACE_EVENT(RCC_OP_RTC_CONFIG, Src, BDCR, Old, New);
+
+    RCC_PROBE_RETURN(RCC_OP_RTC_CONFIG, 0);  // Success
+}
+
+/**
+ * @brief Switches the LSI oscillator (IWDG and optional RTC clock) on or off.
+ *
+ * LSI starts within about 40 us, so the ready flag is awaited (bounded by
+ * RCC_READY_TIMEOUT). LSI cannot be stopped while the IWDG runs.
+ *
+ * @param Status ON to start LSI, OFF to stop it.
+ * @return uint8_t Returns 0 on success, 1 for an invalid status or if LSIRDY did not follow.
+ */
+uint8_t RCC_LSI_SetStatus(STATUS_t Status) {
+    uint32_t Old;
+    uint32_t New;
+    RCC_PROBE_ENTRY();
+
+    if (Status != ON && Status != OFF) {
+        RCC_PROBE_RETURN(RCC_OP_LSI_STATUS, 1);  // Invalid status
+    }
+
+    // Keep RMVF clear so the reset flags survive this store
+    Old = RCC_READ(RCC->CSR);
+    New = (Old & ~((1UL << 24) | (1UL << 0))) | (uint32_t)Status;   // LSION
+    RCC_WRITE(RCC->CSR, New);
+    RCC_TRACE_EVENT(RCC_OP_LSI_STATUS, Status, CSR, Old, New);
+
+    if (RCC_WaitFor(&RCC->CSR, 1 << 1, (uint32_t)Status << 1, RCC_WAIT_OSC_READY, 1)) {
+        RCC_PROBE_RETURN(RCC_OP_LSI_STATUS, 1);  // LSIRDY did not follow
+    }
+
+    RCC_PROBE_RETURN(RCC_OP_LSI_STATUS, 0);  // Success
+}
+
+/**
+ * @brief Returns the cause(s) of the last reset.
+ *
+ * The first call reads RCC_CSR once, caches the flags and clears them in hardware
+ * (RMVF) so the next reset reports only its own cause; later calls return the cached
+ * value without touching the peripheral. Call it after .bss initialization.
+ *
+ * @return uint8_t OR of RCC_RESET_CAUSE_t flags. A value with no bit of
+ *         RCC_RESET_FULL_TEST_MASK set means a benign (pin or software) reset.
+ */
+uint8_t RCC_GetResetCause(void) {
+    static uint8_t Cached;
+    static uint8_t Valid;
+    uint32_t       CSR;
+    RCC_PROBE_ENTRY();
+
+    if (!Valid) {
+        CSR = RCC_READ(RCC->CSR);
+        Cached = (uint8_t)(CSR >> 25);
+        RCC_WRITE(RCC->CSR, CSR | (1UL << 24));   // RMVF
+        RCC_TRACE_EVENT(RCC_OP_RESET_CAUSE, Cached, CSR, CSR, CSR | (1UL << 24));
+        Valid = 1;
+    }
+
+    RCC_PROBE_RETURN(RCC_OP_RESET_CAUSE, Cached);
+}
+
+/********************* Bus and Timer Clocks *********************/
+/**
+ * @brief Returns the AHB clock (HCLK) frequency, from the registers.
+ */
+uint32_t RCC_GetHClkFreq(void) {
+    static const uint16_t AhbDiv[8] = {2, 4, 8, 16, 64, 128, 256, 512};
+    uint32_t              CFGR;
+    uint32_t              Freq;
+    RCC_PROBE_ENTRY();
+
+    CFGR = RCC_READ(RCC->CFGR);
+    Freq = RCC_GetSysClkFreq();
+    if (CFGR & (1 << 7)) {
+        Freq /= AhbDiv[(CFGR >> 4) & 0x7];  // HPRE
+    }
+    RCC_PROBE_RETURN(RCC_OP_BUS_FREQ, Freq);
+}
+
+/**
+ * @brief Returns the APB prescaler of one bus (1, 2, 4, 8 or 16).
+ */
+static uint32_t RCC_ApbDiv(uint8_t Apb2) {
+    uint32_t CFGR = RCC_READ(RCC->CFGR);
+    uint32_t Ppre = Apb2 ? ((CFGR >> 13) & 0x7) : ((CFGR >> 10) & 0x7);  // PPRE2 / PPRE1
+
+    return (Ppre & 0x4) ? (2UL << (Ppre & 0x3)) : 1;
+}
+
+/**
+ * @brief Returns the APB1 clock (PCLK1) frequency, from the registers.
+ */
+uint32_t RCC_GetPClk1Freq(void) {
+    uint32_t Freq;
+    RCC_PROBE_ENTRY();
+
+    Freq = RCC_GetHClkFreq() / RCC_ApbDiv(0);
+    RCC_PROBE_RETURN(RCC_OP_BUS_FREQ, Freq);
+}
+
+/**
+ * @brief Returns the APB2 clock (PCLK2) frequency, from the registers.
+ */
+uint32_t RCC_GetPClk2Freq(void) {
+    uint32_t Freq;
+    RCC_PROBE_ENTRY();
+
+    Freq = RCC_GetHClkFreq() / RCC_ApbDiv(1);
+    RCC_PROBE_RETURN(RCC_OP_BUS_FREQ, Freq);
+}
+
+/**
+ * @brief Returns the kernel clock of the timers on one APB bus, from the registers.
+ *
+ * Timers run at PCLK when the APB prescaler is 1 and at 2 x PCLK otherwise; with
+ * TIMPRE set they run at HCLK up to an APB prescaler of 4 and at 4 x PCLK above.
+ */
+static uint32_t RCC_TimerClkFreq(uint8_t Apb2) {
+    uint32_t Hclk = RCC_GetHClkFreq();
+    uint32_t ApbDiv = RCC_ApbDiv(Apb2);
+
+    if ((RCC_READ(RCC->DCKCFGR) >> 24) & 1) {  // TIMPRE
+        return (ApbDiv <= 4) ? Hclk : Hclk / ApbDiv * 4;
+    }
+    return (ApbDiv == 1) ? Hclk : Hclk / ApbDiv * 2;
+}
+
+/**
+ * @brief Sets the timer clock prescaler selection (DCKCFGR TIMPRE).
+ *
+ * OFF (reset): timers run at 2 x PCLK whenever the APB prescaler is not 1.
+ * ON: timers run at HCLK while the APB prescaler is 1, 2 or 4 and at 4 x PCLK above,
+ * so with the usual APB1 /4 and APB2 /2 every timer is clocked at HCLK (180 MHz).
+ * Timers already running change speed immediately; re-derive their prescalers from
+ * RCC_APB1_GetTimerClkFreq() / RCC_APB2_GetTimerClkFreq().
+ *
+ * @param Status ON or OFF.
+ * @return uint8_t Returns 0 on success, 1 for an invalid status.
+ */
+uint8_t RCC_TIMPRE_SetStatus(STATUS_t Status) {
+    uint32_t Old;
+    uint32_t New;
+    RCC_PROBE_ENTRY();
+
+    if (Status != ON && Status != OFF) {
+        RCC_PROBE_RETURN(RCC_OP_TIMPRE, 1);  // Invalid status
+    }
+
+    Old = RCC_READ(RCC->DCKCFGR);
+    New = (Old & ~(1UL << 24)) | ((uint32_t)Status << 24);
+    RCC_WRITE(RCC->DCKCFGR, New);
+    RCC_TRACE_EVENT(RCC_OP_TIMPRE, Status, DCKCFGR, Old, New);
+
+    RCC_PROBE_RETURN(RCC_OP_TIMPRE, 0);  // Success
+}
+
+/**
+ * @brief Returns the kernel clock of an APB1 timer (TIM2..TIM7, TIM12..TIM14).
+ *
+ * @return uint32_t The frequency in Hz, 0 if the peripheral is not a timer.
+ */
+uint32_t RCC_APB1_GetTimerClkFreq(RCC_APB1_PERIPHERAL_t Peripheral) {
+    uint32_t Freq;
+    RCC_PROBE_ENTRY();
+
+    if ((unsigned)Peripheral > TIM14EN) {
+        RCC_PROBE_RETURN(RCC_OP_TIMER_FREQ, 0);  // Not a timer
+    }
+    Freq = RCC_TimerClkFreq(0);
+    RCC_PROBE_RETURN(RCC_OP_TIMER_FREQ, Freq);
+}
+
+/**
+ * @brief Returns the kernel clock of an APB2 timer (TIM1, TIM8, TIM9..TIM11).
+ *
+ * @return uint32_t The frequency in Hz, 0 if the peripheral is not a timer.
+ */
+uint32_t RCC_APB2_GetTimerClkFreq(RCC_APB2_PERIPHERAL_t Peripheral) {
+    uint32_t Freq;
+    RCC_PROBE_ENTRY();
+
+    if (Peripheral != TIM1EN && Peripheral != TIM8EN && (Peripheral < TIM9EN || Peripheral > TIM11EN)) {
+        RCC_PROBE_RETURN(RCC_OP_TIMER_FREQ, 0);  // Not a timer
+    }
+    Freq = RCC_TimerClkFreq(1);
+    RCC_PROBE_RETURN(RCC_OP_TIMER_FREQ, Freq);
+}
+
+/**
+ * @brief Captures the clock tree state in one pass over the registers.
+ *
+ * @param State Receives the oscillator control words, the Run and Sleep peripheral
+ *              enables and the SYSCLK, HCLK, PCLK1 and PCLK2 frequencies.
+ * @return uint8_t Returns 0 on success, 1 if State is null.
+ */
+uint8_t RCC_GetClkState(RCC_CLK_STATE_t *State) {
+    RCC_PROBE_ENTRY();
+
+    if (State == 0) {
+        RCC_PROBE_RETURN(RCC_OP_CLK_STATE, 1);  // No destination
+    }
+
+    State->CR        = RCC_READ(RCC->CR);
+    State->BDCR      = RCC_READ(RCC->BDCR);
+    State->CSR       = RCC_READ(RCC->CSR);
+    State->AHB1ENR   = RCC_READ(RCC->AHB1ENR);
+    State->AHB2ENR   = RCC_READ(RCC->AHB2ENR);
+    State->AHB3ENR   = RCC_READ(RCC->AHB3ENR);
+    State->APB1ENR   = RCC_READ(RCC->APB1ENR);
+    State->APB2ENR   = RCC_READ(RCC->APB2ENR);
+    State->AHB1LPENR = RCC_READ(RCC->AHB1LPENR);
+    State->AHB2LPENR = RCC_READ(RCC->AHB2LPENR);
+    State->AHB3LPENR = RCC_READ(RCC->AHB3LPENR);
+    State->APB1LPENR = RCC_READ(RCC->APB1LPENR);
+    State->APB2LPENR = RCC_READ(RCC->APB2LPENR);
+    State->SysClk    = RCC_GetSysClkFreq();
+    State->HClk      = RCC_GetHClkFreq();
+    State->PClk1     = RCC_GetPClk1Freq();
+    State->PClk2     = RCC_GetPClk2Freq();
+
+    RCC_PROBE_RETURN(RCC_OP_CLK_STATE, 0);  // Success
+}
+
+/**
+ * @brief Captures a clock on TIM5 CH4 or TIM11 CH1 and counts timer ticks over Periods captures.
+ *
+ * The timer runs free at its kernel clock with the input capture prescaler set to
+ * RCC_MEAS_EDGES, so each capture spans RCC_MEAS_EDGES periods of the measured clock.
+ * The timer clock is enabled for the measurement and restored afterwards; the timer
+ * registers are left at their reset values.
+ *
+ * @return uint8_t Returns 0 on success, 1 if the source is not running, a capture
+ *         timed out or an edge was missed.
+ */
+static uint8_t RCC_MeasureTicks(RCC_MEAS_SRC_t Src, uint32_t Periods, uint64_t *Ticks, uint32_t *TimClk) {
+    TIM_RegDef_t *Tim = (Src == MEAS_HSE_RTC) ? TIM11 : TIM5;
+    uint32_t      WasOn;
+    uint32_t      Flag;
+    uint32_t      Overrun;
+    uint32_t      Mask;
+    uint32_t      Prev;
+    uint32_t      Now;
+    uint32_t      Idx;
+    uint8_t       Result = 0;
+
+    // The source has to be running (and HSE_RTC divided down by RTCPRE)
+    if ((Src == MEAS_LSI && ((RCC_READ(RCC->CSR) >> 1) & 1) == 0) ||
+        (Src == MEAS_LSE && ((RCC_READ(RCC->BDCR) >> 1) & 1) == 0) ||
+        (Src == MEAS_HSE_RTC && (((RCC_READ(RCC->CR) >> 17) & 1) == 0 || ((RCC_READ(RCC->CFGR) >> 16) & 0x1F) < 2))) {
+        return 1;
+    }
+
+    if (Src == MEAS_HSE_RTC) {
+        WasOn = (RCC_READ(RCC->APB2ENR) >> TIM11EN) & 1;
+        (void)RCC_APB2_EnableClk(TIM11EN);
+        *TimClk = RCC_TimerClkFreq(1);
+
+        RCC_WRITE(Tim->OR, 0x2);                          // TI1_RMP: HSE_RTC
+        RCC_WRITE(Tim->CCMR1, (0x1 << 0) | (0x3 << 2));   // CC1S: IC1 on TI1, IC1PSC: /8
+        RCC_WRITE(Tim->CCER, 1 << 0);                     // CC1E
+        RCC_WRITE(Tim->ARR, 0xFFFF);
+        Flag = 1 << 1;       // CC1IF
+        Overrun = 1 << 9;    // CC1OF
+        Mask = 0xFFFF;       // 16-bit counter
+    } else {
+        WasOn = (RCC_READ(RCC->APB1ENR) >> TIM5EN) & 1;
+        (void)RCC_APB1_EnableClk(TIM5EN);
+        *TimClk = RCC_TimerClkFreq(0);
+
+        RCC_WRITE(Tim->OR, (Src == MEAS_LSI) ? (0x1 << 6) : (0x2 << 6));  // TI4_RMP: LSI or LSE
+        RCC_WRITE(Tim->CCMR2, (0x1 << 8) | (0x3 << 10));  // CC4S: IC4 on TI4, IC4PSC: /8
+        RCC_WRITE(Tim->CCER, 1 << 12);                    // CC4E
+        RCC_WRITE(Tim->ARR, 0xFFFFFFFF);
+        Flag = 1 << 4;       // CC4IF
+        Overrun = 1 << 12;   // CC4OF
+        Mask = 0xFFFFFFFF;   // 32-bit counter
+    }
+    RCC_WRITE(Tim->PSC, 0);
+    RCC_WRITE(Tim->EGR, 1 << 0);   // UG: load the prescaler
+    RCC_WRITE(Tim->SR, 0);
+    RCC_WRITE(Tim->CR1, 1 << 0);   // CEN
+
+    // The first capture is the reference, each later one adds an interval
+    *Ticks = 0;
+    Prev = 0;
+    for (Idx = 0; Idx <= Periods && Result == 0; Idx++) {
+        if (RCC_WaitFor(&Tim->SR, Flag, Flag, RCC_WAIT_CAPTURE, 1)) {
+            Result = 1;  // No edge: the source stopped
+        } else {
+            Now = (Src == MEAS_HSE_RTC) ? RCC_READ(Tim->CCR1) : RCC_READ(Tim->CCR4);  // Clears the flag
+            if (Idx > 0) {
+                *Ticks += (Now - Prev) & Mask;
+            }
+            Prev = Now;
+        }
+    }
+    if (RCC_READ(Tim->SR) & Overrun) {
+        Result = 1;  // An edge was missed, the sum is wrong
+    }
+
+    RCC_WRITE(Tim->CR1, 0);
+    RCC_WRITE(Tim->CCER, 0);
+    RCC_WRITE(Tim->CCMR1, 0);
+    RCC_WRITE(Tim->CCMR2, 0);
+    RCC_WRITE(Tim->OR, 0);
+    RCC_WRITE(Tim->SR, 0);
+    if (!WasOn) {
+        if (Src == MEAS_HSE_RTC) {
+            (void)RCC_APB2_DisableClk(TIM11EN);
+        } else {
+            (void)RCC_APB1_DisableClk(TIM5EN);
+        }
+    }
+
+    return (*Ticks == 0) ? 1 : Result;
+}
+
+/**
+ * @brief Measures LSI, LSE or HSE_RTC against the system clock.
+ *
+ * The clock is captured on TIM5 CH4 (LSI, LSE) or TIM11 CH1 (HSE / RTCPRE) and its
+ * period compared with the timer kernel clock, which is derived from SYSCLK. The
+ * result therefore assumes SYSCLK is right: a large error on LSE (a 20 ppm part)
+ * rather means SYSCLK itself is off, see RCC_MeasureSysClk(). The timer used must not
+ * be in use elsewhere during the call.
+ *
+ * @param Src MEAS_LSI, MEAS_LSE or MEAS_HSE_RTC.
+ * @param Periods Number of captures averaged (1..RCC_MEAS_MAX_PERIODS), each spanning
+ *                RCC_MEAS_EDGES periods; 32 LSE captures take about 8 ms.
+ * @param Result Receives the frequency and its deviation from the nominal value
+ *               (RCC_LSI_FREQ, RCC_LSE_FREQ or RCC_HSE_FREQ / RTCPRE).
+ * @return uint8_t Returns 0 on success, 1 for invalid arguments, a stopped source or a
+ *         failed capture.
+ */
+uint8_t RCC_MeasureClk(RCC_MEAS_SRC_t Src, uint32_t Periods, RCC_MEAS_RESULT_t *Result) {
+    uint64_t Ticks;
+    uint64_t Scaled;
+    uint32_t TimClk;
+    uint32_t Nominal;
+    RCC_PROBE_ENTRY();
+
+    if ((unsigned)Src > MEAS_HSE_RTC || Periods == 0 || Periods > RCC_MEAS_MAX_PERIODS || Result == 0) {
+        RCC_PROBE_RETURN(RCC_OP_MEASURE, 1);
+    }
+
+    if (RCC_MeasureTicks(Src, Periods, &Ticks, &TimClk)) {
+        RCC_PROBE_RETURN(RCC_OP_MEASURE, 1);
+    }
+
+    if (Src == MEAS_LSI) {
+        Nominal = RCC_LSI_FREQ;
+    } else if (Src == MEAS_LSE) {
+        Nominal = RCC_LSE_FREQ;
+    } else {
+        Nominal = RCC_HSE_FREQ / ((RCC_READ(RCC->CFGR) >> 16) & 0x1F);  // RTCPRE >= 2, checked above
+    }
+
+    // f = TimClk * edges / ticks, ppm from the same ratio to keep the resolution
+    Scaled = (uint64_t)TimClk * RCC_MEAS_EDGES * Periods;
+    Result->Freq = (uint32_t)((Scaled + Ticks / 2) / Ticks);
+    Result->Ppm = (int32_t)((int64_t)(Scaled * 1000000ULL / Ticks / Nominal) - 1000000);  // < 2^63 up to 180 MHz
+
+    RCC_PROBE_RETURN(RCC_OP_MEASURE, 0);  // Success
+}
+
+/**
+ * @brief Returns A * B / C rounded, for B and C below 2^47, without a 128-bit product.
+ */
+static uint64_t RCC_MulDiv(uint32_t A, uint64_t B, uint64_t C) {
+    uint64_t High = (uint64_t)(A >> 16) * B;                               // < 2^63
+    uint64_t Low  = ((High % C) << 16) + (uint64_t)(A & 0xFFFF) * B + C / 2;  // < 2^64
+
+    return ((High / C) << 16) + Low / C;
+}
+
+/**
+ * @brief Measures the real system clock frequency against LSE.
+ *
+ * LSE (a 32.768 kHz crystal, typically +/-20 ppm) is used as the reference, so this
+ * reveals a wrong HSE crystal or the HSI error when SYSCLK runs from HSI. LSE must be
+ * running.
+ *
+ * @param Periods Number of LSE captures averaged (1..RCC_MEAS_MAX_PERIODS).
+ * @param Result Receives the real SYSCLK frequency and its deviation from the value
+ *               computed from the registers (RCC_GetSysClkFreq()).
+ * @return uint8_t Returns 0 on success, 1 for invalid arguments, LSE not running or a
+ *         failed capture.
+ */
+uint8_t RCC_MeasureSysClk(uint32_t Periods, RCC_MEAS_RESULT_t *Result) {
+    uint64_t Ticks;
+    uint64_t Num;
+    uint64_t Den;
+    uint32_t TimClk;
+    uint32_t SysClk = RCC_GetSysClkFreq();
+    RCC_PROBE_ENTRY();
+
+    if (Periods == 0 || Periods > RCC_MEAS_MAX_PERIODS || Result == 0 || SysClk == 0) {
+        RCC_PROBE_RETURN(RCC_OP_MEASURE, 1);
+    }
+    if (RCC_MeasureTicks(MEAS_LSE, Periods, &Ticks, &TimClk)) {
+        RCC_PROBE_RETURN(RCC_OP_MEASURE, 1);
+    }
+
+    // f = SysClk * Ticks * LSE / (TimClk * edges), both terms < 2^43 up to 180 MHz
+    Num = Ticks * RCC_LSE_FREQ;
+    Den = (uint64_t)TimClk * RCC_MEAS_EDGES * Periods;
+    Result->Freq = (uint32_t)RCC_MulDiv(SysClk, Num, Den);
+    Result->Ppm = (int32_t)((int64_t)((Num * 1000000ULL + Den / 2) / Den) - 1000000);  // < 2^63
+
+    RCC_PROBE_RETURN(RCC_OP_MEASURE, 0);  // Success
+}
+
+/********************* HSI Trimming *********************/
+static int32_t RCC_HsiStepPpm = RCC_HSI_TRIM_STEP_PPM;  // HSI change per HSITRIM step, refined by RCC_HSI_Calibrate()
+
+static inline int32_t RCC_AbsPpm(int32_t Ppm) {
+    return (Ppm < 0) ? -Ppm : Ppm;
+}
+
+/**
+ * @brief Tells whether SYSCLK is derived from HSI, directly or through the main PLL.
+ */
+static uint8_t RCC_HSI_DrivesSysClk(void) {
+    uint32_t Sws = (RCC_READ(RCC->CFGR) >> 2) & 0x3;
+
+    return (Sws == SYSHSI) || (Sws >= SYSPLLP && ((RCC_READ(RCC->PLLCFGR) >> 22) & 1) == 0);
+}
+
+static void RCC_HSI_SetTrim(uint32_t Trim) {
+    uint32_t Old = RCC_READ(RCC->CR);
+    uint32_t New = (Old & ~(0x1FUL << 3)) | (Trim << 3);  // HSITRIM
+
+    RCC_WRITE(RCC->CR, New);
+    RCC_TRACE_EVENT(RCC_OP_HSI_TRIM, Trim, CR, Old, New);
+}
+
+/**
+ * @brief Trims HSI against LSE for the smallest frequency error.
+ *
+ * HSI rises with HSITRIM, so starting from the current value the trim is moved one step
+ * at a time against the measured error until the error stops shrinking or changes sign;
+ * the best setting is kept. A factory-calibrated part typically needs a few steps, each
+ * costing one RCC_MeasureSysClk() of Periods LSE captures (32 captures: about 8 ms).
+ * A step that changes the reading replaces the nominal RCC_HSI_TRIM_STEP_PPM used by
+ * RCC_HSI_Retrim(); when no step is taken or two readings are equal it is kept.
+ *
+ * SYSCLK must run from HSI (directly or through the PLL) and LSE must be running.
+ *
+ * @param Periods Number of LSE captures per measurement (1..RCC_MEAS_MAX_PERIODS).
+ * @param Result Receives the HSI-derived SYSCLK and its remaining error in ppm.
+ * @return uint8_t Returns 0 on success, 1 if HSI does not drive SYSCLK, a measurement
+ *         failed (the best trim found so far is kept) or no trim step size is known.
+ */
+uint8_t RCC_HSI_Calibrate(uint32_t Periods, RCC_MEAS_RESULT_t *Result) {
+    RCC_MEAS_RESULT_t Best;
+    RCC_MEAS_RESULT_t Next;
+    uint32_t          BestTrim;
+    uint32_t          Trim;
+    uint8_t           Crossed;
+    uint8_t           Failed = 0;
+    RCC_PROBE_ENTRY();
+
+    if (Result == 0 || !RCC_HSI_DrivesSysClk() || RCC_MeasureSysClk(Periods, &Best)) {
+        RCC_PROBE_RETURN(RCC_OP_HSI_TRIM, 1);
+    }
+    BestTrim = (RCC_READ(RCC->CR) >> 3) & 0x1F;
+    Trim = BestTrim;
+
+    while (Best.Ppm != 0 && !(Best.Ppm > 0 && Trim == 0) && !(Best.Ppm < 0 && Trim == 0x1F)) {
+        Trim = (Best.Ppm > 0) ? Trim - 1 : Trim + 1;
+        RCC_HSI_SetTrim(Trim);
+        if (RCC_MeasureSysClk(Periods, &Next)) {
+            Failed = 1;
+            break;
+        }
+        if (Next.Ppm != Best.Ppm) {
+            RCC_HsiStepPpm = RCC_AbsPpm(Best.Ppm - Next.Ppm);  // Only a real difference refines the step
+        }
+
+        Crossed = (Next.Ppm > 0) != (Best.Ppm > 0);
+        if (RCC_AbsPpm(Next.Ppm) >= RCC_AbsPpm(Best.Ppm)) {
+            break;  // No better than the previous step
+        }
+        Best = Next;
+        BestTrim = Trim;
+        if (Crossed) {
+            break;  // The optimum lies between the last two steps
+        }
+    }
+    if (Trim != BestTrim) {
+        RCC_HSI_SetTrim(BestTrim);
+    }
+    *Result = Best;
+    if (RCC_HsiStepPpm == 0) {
+        Failed = 1;  // RCC_HSI_Retrim() would have nothing to work with
+    }
+
+    RCC_PROBE_RETURN(RCC_OP_HSI_TRIM, Failed);
+}
+
+/**
+ * @brief Corrects HSI drift by at most one HSITRIM step.
+ *
+ * Meant to be called periodically (for example once per second or on a temperature
+ * change): one measurement of Periods LSE captures, then a single CR store when the
+ * error exceeds half a trim step. The step is the nominal RCC_HSI_TRIM_STEP_PPM until
+ * RCC_HSI_Calibrate() has measured it.
+ *
+ * @param Periods Number of LSE captures (1..RCC_MEAS_MAX_PERIODS); 8 take about 2 ms.
+ * @param Result Receives the error measured before the correction.
+ * @return uint8_t Returns 0 on success, 1 if no trim step size is known, HSI does not
+ *         drive SYSCLK or the measurement failed.
+ */
+uint8_t RCC_HSI_Retrim(uint32_t Periods, RCC_MEAS_RESULT_t *Result) {
+    uint32_t Trim;
+    RCC_PROBE_ENTRY();
+
+    if (RCC_HsiStepPpm == 0 || Result == 0 || !RCC_HSI_DrivesSysClk() || RCC_MeasureSysClk(Periods, Result)) {
+        RCC_PROBE_RETURN(RCC_OP_HSI_TRIM, 1);
+    }
+
+    Trim = (RCC_READ(RCC->CR) >> 3) & 0x1F;
+    if (Result->Ppm > RCC_HsiStepPpm / 2 && Trim > 0) {
+        RCC_HSI_SetTrim(Trim - 1);
+    } else if (Result->Ppm < -RCC_HsiStepPpm / 2 && Trim < 0x1F) {
+        RCC_HSI_SetTrim(Trim + 1);
+    }
+
+    RCC_PROBE_RETURN(RCC_OP_HSI_TRIM, 0);  // Success
+}
+
+/********************* Clock-Aware Delay and SysTick *********************/
+static uint32_t RCC_CyclesPerUsQ8;  // HCLK cycles per microsecond in 1/256 units, 0 until first computed
+
+/**
+ * @brief Recomputes the delay scale from HCLK and reloads SysTick (RCC_SYSTICK_HZ).
+ *
+ * Called by every function that changes the system clock, so RCC_DelayUs() needs no
+ * division. RCC_EarlyInit() runs before .bss is set up and does not call it; the
+ * first RCC_DelayUs() then computes the scale itself.
+ */
+static void RCC_ClockChanged(void) {
+    uint32_t Hclk = RCC_GetHClkFreq();
+#if RCC_SYSTICK_HZ
+    uint32_t Reload = (((RCC_READ(SYSTICK->CTRL) >> 2) & 1) ? Hclk : Hclk / 8) / RCC_SYSTICK_HZ;  // CLKSOURCE
+
+    if (Reload >= 2 && Reload <= 0x01000000UL) {
+        RCC_WRITE(SYSTICK->LOAD, Reload - 1);
+        RCC_WRITE(SYSTICK->VAL, 0);  // Start the next period at the new rate
+    }
+#endif
+
+    RCC_CycleCounterStart();
+    RCC_CyclesPerUsQ8 = (uint32_t)(((uint64_t)Hclk << 8) / 1000000UL);
+}
+
+/**
+ * @brief Busy-waits for a number of microseconds at the current HCLK.
+ *
+ * Counts DWT CYCCNT cycles against a scale cached at each clock change (one multiply
+ * per call), so the delay stays right across RCC_SetSysClk() / RCC_LoadImage().
+ * Interrupts taken during the wait lengthen it. The longest delay is 2^32 cycles
+ * (about 23 s at 180 MHz).
+ *
+ * @param Us The delay in microseconds.
+ */
+void RCC_DelayUs(uint32_t Us) {
+    uint32_t Start;
+    uint32_t Cycles;
+
+    if (RCC_CyclesPerUsQ8 == 0) {
+        RCC_ClockChanged();  // First use after reset or RCC_EarlyInit()
+    }
+
+    Start = RCC_READ(DWT->CYCCNT);
+    Cycles = (uint32_t)(((uint64_t)Us * RCC_CyclesPerUsQ8) >> 8);
+    while ((RCC_READ(DWT->CYCCNT) - Start) < Cycles) {
+    }
+}
+
+/********************* Spread Spectrum *********************/
+/**
+ * @brief Configures spread-spectrum modulation of the main PLL (RCC_SSCGR).
+ *
+ * MODPER and INCSTEP are computed from the current PLL input (source / PLLM) and PLLN
+ * as given in RM0390 section 6.3.22:
+ *   MODPER  = round(f_PLL_IN / (4 x ModFreq))
+ *   INCSTEP = round((2^15 - 1) x depth[%] x PLLN / (100 x 5 x MODPER))
+ * and checked against the register limits (MODPER < 2^13, INCSTEP < 2^15 and
+ * MODPER x INCSTEP <= 2^15 - 1), so configure PLLM / PLLN first. SSCGR may only change
+ * while the PLL is off: a running PLL is stopped, reprogrammed and relocked, which is
+ * refused while it drives SYSCLK.
+ *
+ * @param ModFreq Modulation frequency in Hz (1..RCC_SSCG_MAX_MOD_FREQ).
+ * @param Depth Peak modulation depth in 0.01 % units (1..RCC_SSCG_MAX_DEPTH); 0 turns
+ *              the modulation off.
+ * @param Spread SSCG_CENTER or SSCG_DOWN.
+ * @return uint8_t Returns 0 on success, 1 for values out of range, an invalid PLL setup,
+ *         a PLL driving SYSCLK or a PLL that did not relock.
+ */
+uint8_t RCC_SSCG_Config(uint32_t ModFreq, uint16_t Depth, RCC_SSCG_SPREAD_t Spread) {
+    uint32_t PLLCFGR = RCC_READ(RCC->PLLCFGR);
+    uint32_t M = PLLCFGR & 0x3F;
+    uint32_t N = (PLLCFGR >> 6) & 0x1FF;
+    uint32_t PllIn;
+    uint32_t ModPer = 0;
+    uint32_t IncStep = 0;
+    uint32_t Value = 0;
+    uint8_t  WasOn;
+    RCC_PROBE_ENTRY();
+
+    if (Depth != 0) {
+        if (ModFreq == 0 || ModFreq > RCC_SSCG_MAX_MOD_FREQ || Depth > RCC_SSCG_MAX_DEPTH ||
+            (Spread != SSCG_CENTER && Spread != SSCG_DOWN) || M < 2 || N < 50) {
+            RCC_PROBE_RETURN(RCC_OP_SSCG_CONFIG, 1);
+        }
+        PllIn = (((PLLCFGR >> 22) & 1) ? RCC_HSE_FREQ : RCC_HSI_FREQ) / M;
+        ModPer = (PllIn + 2 * ModFreq) / (4 * ModFreq);
+        if (ModPer == 0 || ModPer > 0x1FFF) {
+            RCC_PROBE_RETURN(RCC_OP_SSCG_CONFIG, 1);
+        }
+        IncStep = (uint32_t)((32767ULL * Depth * N + 25000ULL * ModPer) / (50000ULL * ModPer));
+        if (IncStep == 0 || IncStep > 0x7FFF || ModPer * IncStep > 32767) {
+            RCC_PROBE_RETURN(RCC_OP_SSCG_CONFIG, 1);  // Depth too small or too large for this PLL setup
+        }
+        Value = (1UL << 31) | ((uint32_t)Spread << 30) | (IncStep << 13) | ModPer;   // SSCGEN
+    }
+
+    WasOn = (RCC_READ(RCC->CR) >> 24) & 1;
+    if (WasOn && RCC_PLL_Stop()) {
+        RCC_PROBE_RETURN(RCC_OP_SSCG_CONFIG, 1);
+    }
+
+    RCC_TRACE_SNAPSHOT(Old, RCC_READ(RCC->SSCGR));
+    RCC_WRITE(RCC->SSCGR, Value);
+    RCC_TRACE_EVENT(RCC_OP_SSCG_CONFIG, Depth, SSCGR, Old, Value);
+
+    if (WasOn && RCC_PLL_Start()) {
+        RCC_PROBE_RETURN(RCC_OP_SSCG_CONFIG, 1);
+    }
+
+    RCC_PROBE_RETURN(RCC_OP_SSCG_CONFIG, 0);  // Success
+}
+
+/********************* Peripheral Kernel Clocks *********************/
+/**
+ * @brief Returns the output of the main PLL, PLLI2S or PLLSAI for its config word.
+ *
+ * The three PLLs share the M (5:0) and N (14:6) layout and the PLLSRC input.
+ */
+static uint32_t RCC_PllOutFreq(uint32_t Cfg, uint32_t Div) {
+    uint32_t InFreq = ((RCC_READ(RCC->PLLCFGR) >> 22) & 1) ? RCC_HSE_FREQ : RCC_HSI_FREQ;
+    uint32_t M = Cfg & 0x3F;
+
+    if (M < 2 || Div == 0) {
+        return 0;  // Invalid factors
+    }
+    return (uint32_t)((unsigned long long)InFreq * ((Cfg >> 6) & 0x1FF) / M / Div);
+}
+
+// Field and sources of each kernel clock multiplexer (RM0390 sections 6.3.24 and 6.3.26)
+static const RCC_KERNEL_MUX_t RCC_KernelMux[KERNEL_COUNT] = {
+    [KERNEL_SAI1]     = {0, PLLR_SAI1, 2, {KSRC_PLLSAI_Q, KSRC_PLLI2S_Q, KSRC_PLLR, KSRC_I2S_CKIN}},
+    [KERNEL_SAI2]     = {0, PLLR_SAI2, 2, {KSRC_PLLSAI_Q, KSRC_PLLI2S_Q, KSRC_PLLR, KSRC_PLL_SRC}},
+    [KERNEL_I2S_APB2] = {0, PLLR_I2S2, 2, {KSRC_PLLI2S_R, KSRC_I2S_CKIN, KSRC_PLLR, KSRC_PLL_SRC}},
+    [KERNEL_I2S_APB1] = {0, PLLR_I2S1, 2, {KSRC_PLLI2S_R, KSRC_I2S_CKIN, KSRC_PLLR, KSRC_PLL_SRC}},
+    [KERNEL_FMPI2C1]  = {1, 22, 2, {KSRC_PCLK1, KSRC_SYSCLK, KSRC_HSI, KSRC_NONE}},
+    [KERNEL_CEC]      = {1, 26, 1, {KSRC_LSE, KSRC_HSI_488}},
+    [KERNEL_CK48]     = {1, 27, 1, {KSRC_PLLQ, KSRC_PLLSAI_P}},
+    [KERNEL_SDIO]     = {1, 28, 1, {KSRC_CK48, KSRC_SYSCLK}},
+    [KERNEL_SPDIFRX]  = {1, 29, 1, {KSRC_PLLR, KSRC_PLLI2S_P}},
+};
+
+/**
+ * @brief Selects the kernel clock source of a peripheral.
+ *
+ * One read-modify-write of DCKCFGR or DCKCFGR2. The source must be one the peripheral
+ * multiplexer offers (see RCC_KERNEL_SRC_t and RM0390); the PLL feeding it is not
+ * started here. Change the source while the peripheral is disabled.
+ *
+ * @param Kernel The peripheral kernel clock (KERNEL_SAI1 ... KERNEL_SPDIFRX).
+ * @param Src The source to select.
+ * @return uint8_t Returns 0 on success, 1 for an invalid kernel or a source the
+ *         peripheral cannot use.
+ */
+uint8_t RCC_Kernel_SetSource(RCC_KERNEL_t Kernel, RCC_KERNEL_SRC_t Src) {
+    const RCC_KERNEL_MUX_t *Mux;
+    uint32_t                Value;
+    uint32_t                Mask;
+    uint32_t                Old;
+    uint32_t                New;
+    RCC_PROBE_ENTRY();
+
+    if ((unsigned)Kernel >= KERNEL_COUNT || Src == KSRC_NONE) {
+        RCC_PROBE_RETURN(RCC_OP_KERNEL_SRC, 1);
+    }
+    Mux = &RCC_KernelMux[Kernel];
+    Value = 0;
+    while (Value < (1UL << Mux->Width) && Mux->Src[Value] != Src) {
+        Value++;
+    }
+    if (Value == (1UL << Mux->Width)) {
+        RCC_PROBE_RETURN(RCC_OP_KERNEL_SRC, 1);  // Not offered by this multiplexer
+    }
+
+    Mask = ((1UL << Mux->Width) - 1) << Mux->Pos;
+    if (Mux->Dckcfgr2) {
+        Old = RCC_READ(RCC->DCKCFGR2);
+        New = (Old & ~Mask) | (Value << Mux->Pos);
+        RCC_WRITE(RCC->DCKCFGR2, New);
+        RCC_TRACE_EVENT(RCC_OP_KERNEL_SRC, Kernel, DCKCFGR2, Old, New);
+    } else {
+        Old = RCC_READ(RCC->DCKCFGR);
+        New = (Old & ~Mask) | (Value << Mux->Pos);
+        RCC_WRITE(RCC->DCKCFGR, New);
+        RCC_TRACE_EVENT(RCC_OP_KERNEL_SRC, Kernel, DCKCFGR, Old, New);
+    }
+
+    RCC_PROBE_RETURN(RCC_OP_KERNEL_SRC, 0);  // Success
+}
+
+/**
+ * @brief Returns the kernel clock source currently selected for a peripheral.
+ */
+RCC_KERNEL_SRC_t RCC_Kernel_GetSource(RCC_KERNEL_t Kernel) {
+    const RCC_KERNEL_MUX_t *Mux;
+    uint32_t                Reg;
+    RCC_KERNEL_SRC_t        Src;
+    RCC_PROBE_ENTRY();
+
+    if ((unsigned)Kernel >= KERNEL_COUNT) {
+        RCC_PROBE_RETURN(RCC_OP_KERNEL_QUERY, KSRC_NONE);
+    }
+    Mux = &RCC_KernelMux[Kernel];
+    Reg = Mux->Dckcfgr2 ? RCC_READ(RCC->DCKCFGR2) : RCC_READ(RCC->DCKCFGR);
+    Src = (RCC_KERNEL_SRC_t)Mux->Src[(Reg >> Mux->Pos) & ((1UL << Mux->Width) - 1)];
+    RCC_PROBE_RETURN(RCC_OP_KERNEL_QUERY, Src);
+}
+
+/**
+ * @brief Returns the frequency of a kernel clock source, from the registers.
+ *
+ * PLL outputs count only while their PLL is locked; I2S_CKIN is RCC_I2S_CKIN_FREQ.
+ */
+static uint32_t RCC_KernelSrcFreq(RCC_KERNEL_SRC_t Src) {
+    uint32_t CR = RCC_READ(RCC->CR);
+    uint32_t Cfg;
+
+    switch (Src) {
+        case KSRC_PLLQ:
+        case KSRC_PLLR:
+            Cfg = RCC_READ(RCC->PLLCFGR);
+            if (((CR >> 25) & 1) == 0) {
+                return 0;  // PLL not locked
+            }
+            return RCC_PllOutFreq(Cfg, (Src == KSRC_PLLQ) ? ((Cfg >> 24) & 0xF) : ((Cfg >> 28) & 0x7));
+        case KSRC_PLLI2S_P:
+        case KSRC_PLLI2S_Q:
+        case KSRC_PLLI2S_R:
+            Cfg = RCC_READ(RCC->PLLI2SCFGR);
+            if (((CR >> 27) & 1) == 0) {
+                return 0;  // PLLI2S not locked
+            }
+            if (Src == KSRC_PLLI2S_P) {
+                return RCC_PllOutFreq(Cfg, (((Cfg >> 16) & 0x3) + 1) * 2);
+            }
+            if (Src == KSRC_PLLI2S_R) {
+                return RCC_PllOutFreq(Cfg, (Cfg >> 28) & 0x7);
+            }
+            return RCC_PllOutFreq(Cfg, (Cfg >> 24) & 0xF) / ((RCC_READ(RCC->DCKCFGR) & 0x1F) + 1);   // PLLI2SDIVQ
+        case KSRC_PLLSAI_P:
+        case KSRC_PLLSAI_Q:
+            Cfg = RCC_READ(RCC->PLLSAICFGR);
+            if (((CR >> 29) & 1) == 0) {
+                return 0;  // PLLSAI not locked
+            }
+            if (Src == KSRC_PLLSAI_P) {
+                return RCC_PllOutFreq(Cfg, (((Cfg >> 16) & 0x3) + 1) * 2);
+            }
+            return RCC_PllOutFreq(Cfg, (Cfg >> 24) & 0xF) / (((RCC_READ(RCC->DCKCFGR) >> 8) & 0x1F) + 1);  // PLLSAIDIVQ
+        case KSRC_PLL_SRC:
+            return ((RCC_READ(RCC->PLLCFGR) >> 22) & 1) ? RCC_HSE_FREQ : RCC_HSI_FREQ;
+        case KSRC_I2S_CKIN: return RCC_I2S_CKIN_FREQ;
+        case KSRC_SYSCLK:   return RCC_GetSysClkFreq();
+        case KSRC_PCLK1:    return RCC_GetPClk1Freq();
+        case KSRC_HSI:      return RCC_HSI_FREQ;
+        case KSRC_HSI_488:  return RCC_HSI_FREQ / 488;
+        case KSRC_LSE:      return RCC_LSE_FREQ;
+        case KSRC_CK48:     return RCC_KernelSrcFreq(RCC_Kernel_GetSource(KERNEL_CK48));
+        default:            return 0;
+    }
+}
+
+/**
+ * @brief Returns the kernel clock frequency of a peripheral, from the registers.
+ *
+ * @return uint32_t The frequency in Hz, 0 for an invalid kernel or a source that is
+ *         not running (PLL unlocked, I2S_CKIN not declared).
+ */
+uint32_t RCC_Kernel_GetFreq(RCC_KERNEL_t Kernel) {
+    uint32_t Freq;
+    RCC_PROBE_ENTRY();
+
+    Freq = RCC_KernelSrcFreq(RCC_Kernel_GetSource(Kernel));
+    RCC_PROBE_RETURN(RCC_OP_KERNEL_QUERY, Freq);
+}
+
+/********************* Automatic Clock Gating *********************/
+/**
+ * @brief Selects which blocks the hardware may clock-gate while idle (RCC_CKGATENR).
+ *
+ * Every block in Gated keeps its automatic gating; every other block is clocked all
+ * the time. The profiles RCC_CKGATE_PROFILE_* cover the usual cases: LOW_ACTIVITY lets
+ * the bridges, ETM, spare and RCC interfaces gate but keeps SRAM and flash clocked, so
+ * instruction fetch and data accesses see no extra delay.
+ *
+ * Latency: a gated block has its clock restored by the next access to it; RM0390 gives
+ * no figure for this and none has been measured with this driver yet. Treat gating as
+ * adding up to a few cycles to the first access after an idle period, measure it on
+ * the target with the DWT probes (RCC_INSTRUMENTATION) before relying on it in
+ * latency-critical code, and switch to RCC_CKGATE_PROFILE_NONE around such phases.
+ *
+ * @param Gated OR of RCC_CKGATE_t flags, or an RCC_CKGATE_PROFILE_* value.
+ * @return uint8_t Returns 0 on success, 1 for bits outside CKGATE_ALL.
+ */
+uint8_t RCC_CKGATE_SetProfile(uint8_t Gated) {
+    RCC_PROBE_ENTRY();
+
+    if ((Gated & ~CKGATE_ALL) != 0) {
+        RCC_PROBE_RETURN(RCC_OP_CKGATE, 1);  // Unknown block
+    }
+
+    RCC_TRACE_SNAPSHOT(Old, RCC_READ(RCC->CKGATENR));
+    RCC_WRITE(RCC->CKGATENR, ~(uint32_t)Gated & CKGATE_ALL);   // 1: clock always on
+    RCC_TRACE_EVENT(RCC_OP_CKGATE, Gated, CKGATENR, Old, ~(uint32_t)Gated & CKGATE_ALL);
+
+    RCC_PROBE_RETURN(RCC_OP_CKGATE, 0);  // Success
+}
+
+/**
+ * @brief Returns the blocks currently allowed to clock-gate (OR of RCC_CKGATE_t flags).
+ */
+uint8_t RCC_CKGATE_GetProfile(void) {
+    uint8_t Gated;
+    RCC_PROBE_ENTRY();
+
+    Gated = (uint8_t)(~RCC_READ(RCC->CKGATENR) & CKGATE_ALL);
+    RCC_PROBE_RETURN(RCC_OP_CKGATE, Gated);
+}
+
+/********************* Peripheral Groups *********************/
+#define RCC_EN(P)    (1UL << (P))
+
+/* USB OTG FS device: PA11/PA12, 48 MHz from PLLQ (configure PLLQ for 48 MHz) */
+const RCC_GROUP_t RCC_GROUP_USB_FS = {
+    .AHB1ENR = RCC_EN(GPIOAEN),
+    .AHB2ENR = RCC_EN(OTGFSEN),
+    .DCKCFGR2_Mask = 1UL << 27, .DCKCFGR2 = 0,                           // CK48MSEL: PLLQ
+};
+
+/*
+ * I2S audio out on SPI2 (PB12/PB13/PB15, MCK on PC6) with DMA1, kernel clock from
+ * PLLI2S R: 1 MHz PLL input, N = 258, R = 3 -> 86 MHz, the RM0390 entry for 48 kHz
+ * with MCK. Assumes the PLLs run from HSE and RCC_HSE_FREQ is a whole number of MHz;
+ * RCC_Group_Enable() refuses it when PLLSRC is HSI (VCO 516 MHz).
+ */
+const RCC_GROUP_t RCC_GROUP_AUDIO_I2S2 = {
+    .AHB1ENR = RCC_EN(GPIOBEN) | RCC_EN(GPIOCEN) | RCC_EN(DMA1EN),
+    .APB1ENR = RCC_EN(SPI2EN),
+    .DCKCFGR_Mask = 0x3UL << PLLR_I2S1, .DCKCFGR = 0,                    // I2S1SRC (KERNEL_I2S_APB1): PLLI2S R
+    .PLLI2SCFGR = (3UL << 28) | (2UL << 24) | (258UL << 6) | (RCC_HSE_FREQ / 1000000UL),
+};
+
+/* SD card on SDIO (PC8..PC12, PD2) with DMA2, kernel clock from CK48 = PLLQ */
+const RCC_GROUP_t RCC_GROUP_SDIO = {
+    .AHB1ENR = RCC_EN(GPIOCEN) | RCC_EN(GPIODEN) | RCC_EN(DMA2EN),
+    .APB2ENR = RCC_EN(SDIOEN),
+    .DCKCFGR2_Mask = (1UL << 28) | (1UL << 27), .DCKCFGR2 = 0,           // SDIOSEL: CK48, CK48MSEL: PLLQ
+};
+
+/**
+ * @brief Sets the Mask bits of a register to Bits with one read and one store; no access when Mask is 0.
+ */
+static void RCC_Group_Update(volatile uint32_t *Reg, uint32_t Mask, uint32_t Bits) {
+    uint32_t Old;
+
+    if (Mask == 0) {
+        return;
+    }
+    Old = RCC_READ(*Reg);
+    RCC_WRITE(*Reg, (Old & ~Mask) | Bits);
+    RCC_TRACE_EVENT_AT(RCC_OP_GROUP, 0, Reg, Old, (Old & ~Mask) | Bits);
+}
+
+/**
+ * @brief Programs and starts PLLI2S or PLLSAI for a group.
+ *
+ * A PLL that already runs with the same word is shared; one running with other
+ * factors belongs to another subsystem and is left alone (error). Both PLLs take
+ * their input from the main PLLSRC, so M and N of Word are checked against the VCO
+ * limits for the source actually selected before anything is written. Started is set
+ * only when this call turned the PLL on and it locked.
+ */
+static uint8_t RCC_Group_StartPLL(volatile uint32_t *CfgReg, uint32_t Word, uint32_t OnBit, uint8_t *Started) {
+    uint32_t           CR = RCC_READ(RCC->CR);
+    CLK_t              Src = ((RCC_READ(RCC->PLLCFGR) >> 22) & 1) ? HSE : HSI;  // PLLSRC
+    unsigned long long VcoIn = RCC_VCO_IN_FREQ(RCC_HSE_FREQ, Src, Word & 0x3F);
+    unsigned long long VcoOut = RCC_VCO_OUT_FREQ(RCC_HSE_FREQ, Src, Word & 0x3F, (Word >> 6) & 0x1FF);
+
+    *Started = 0;
+    if ((CR >> OnBit) & 1) {
+        return (RCC_READ(*CfgReg) == Word) ? 0 : 1;
+    }
+    if (VcoIn < RCC_VCO_IN_MIN_FREQ || VcoIn > RCC_VCO_IN_MAX_FREQ ||
+        VcoOut < RCC_VCO_OUT_MIN_FREQ || VcoOut > RCC_VCO_OUT_MAX_FREQ) {
+        return 1;  // M and N do not suit the PLLSRC in use
+    }
+    RCC_WRITE(*CfgReg, Word);
+    RCC_WRITE(RCC->CR, CR | (1UL << OnBit));
+    RCC_TRACE_EVENT(RCC_OP_GROUP, OnBit, CR, CR, CR | (1UL << OnBit));
+    if (RCC_WaitFor(&RCC->CR, 1UL << (OnBit + 1), 1UL << (OnBit + 1), RCC_WAIT_PLL_LOCK, 1)) {  // PLLxRDY
+        RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~(1UL << OnBit));
+        return 1;  // Did not lock
+    }
+    *Started = 1;
+    return 0;
+}
+
+/**
+ * @brief Brings up the clocks of a whole subsystem.
+ *
+ * The auxiliary PLL (if any) is started first, then the kernel clock fields are set,
+ * then the bus clocks are enabled, so every peripheral starts on its final kernel
+ * clock. Each register the group touches costs one read and one store; untouched
+ * registers are not accessed. Compared with one RCC_xxx_EnableClk() per peripheral,
+ * a group of n enables on one bus saves n - 1 read-modify-writes.
+ *
+ * @param Group A group descriptor, e.g. &RCC_GROUP_USB_FS.
+ * @return uint8_t Returns 0 on success, 1 for a null group, an auxiliary PLL already
+ *         running with other factors, one whose VCO input or output would be out of
+ *         range for the current PLLSRC or one that did not lock (a PLLI2S started by
+ *         this call is stopped again and nothing else is changed).
+ */
+uint8_t RCC_Group_Enable(const RCC_GROUP_t *Group) {
+    uint8_t I2sStarted = 0;
+    uint8_t SaiStarted;
+    RCC_PROBE_ENTRY();
+
+    if (Group == 0) {
+        RCC_PROBE_RETURN(RCC_OP_GROUP, 1);
+    }
+    if (Group->PLLI2SCFGR != 0 && RCC_Group_StartPLL(&RCC->PLLI2SCFGR, Group->PLLI2SCFGR, 26, &I2sStarted)) {
+        RCC_PROBE_RETURN(RCC_OP_GROUP, 1);
+    }
+    if (Group->PLLSAICFGR != 0 && RCC_Group_StartPLL(&RCC->PLLSAICFGR, Group->PLLSAICFGR, 28, &SaiStarted)) {
+        if (I2sStarted) {
+            RCC_WRITE(RCC->CR, RCC_READ(RCC->CR) & ~(1UL << 26));  // PLLI2SON: undo this call
+        }
+        RCC_PROBE_RETURN(RCC_OP_GROUP, 1);
+    }
+
+    RCC_Group_Update(&RCC->DCKCFGR, Group->DCKCFGR_Mask, Group->DCKCFGR);
+    RCC_Group_Update(&RCC->DCKCFGR2, Group->DCKCFGR2_Mask, Group->DCKCFGR2);
+    RCC_Group_Update(&RCC->AHB1ENR, Group->AHB1ENR, Group->AHB1ENR);
+    RCC_Group_Update(&RCC->AHB2ENR, Group->AHB2ENR, Group->AHB2ENR);
+    RCC_Group_Update(&RCC->AHB3ENR, Group->AHB3ENR, Group->AHB3ENR);
+    RCC_Group_Update(&RCC->APB1ENR, Group->APB1ENR, Group->APB1ENR);
+    RCC_Group_Update(&RCC->APB2ENR, Group->APB2ENR, Group->APB2ENR);
+
+    RCC_PROBE_RETURN(RCC_OP_GROUP, 0);  // Success
+}
+
+/**
+ * @brief Disables the bus clocks of a subsystem.
+ *
+ * Kernel clock selections and auxiliary PLLs are left as they are, since other
+ * subsystems may share them. The GPIO ports of the group are disabled too; re-enable
+ * any port another subsystem still uses.
+ *
+ * @return uint8_t Returns 0 on success, 1 for a null group.
+ */
+uint8_t RCC_Group_Disable(const RCC_GROUP_t *Group) {
+    RCC_PROBE_ENTRY();
+
+    if (Group == 0) {
+        RCC_PROBE_RETURN(RCC_OP_GROUP, 1);
+    }
+    RCC_Group_Update(&RCC->AHB1ENR, Group->AHB1ENR, 0);
+    RCC_Group_Update(&RCC->AHB2ENR, Group->AHB2ENR, 0);
+    RCC_Group_Update(&RCC->AHB3ENR, Group->AHB3ENR, 0);
+    RCC_Group_Update(&RCC->APB1ENR, Group->APB1ENR, 0);
+    RCC_Group_Update(&RCC->APB2ENR, Group->APB2ENR, 0);
+
+    RCC_PROBE_RETURN(RCC_OP_GROUP, 0);  // Success
+}
+
+/********************* Clock Outputs *********************/
+/**
+ * @brief Returns the frequency an MCO source runs at, from the registers, 0 if the
+ *        source is not ready.
+ */
+static uint32_t RCC_MCO_SrcFreq(RCC_MCO_SRC_t Src) {
+    uint32_t CR = RCC_READ(RCC->CR);
+    uint32_t Cfg;
+
+    switch (Src) {
+        case MCO1_HSI:
+            return ((CR >> 1) & 1) ? RCC_HSI_FREQ : 0;                                   // HSIRDY
+        case MCO1_LSE:
+            return ((RCC_READ(RCC->BDCR) >> 1) & 1) ? RCC_LSE_FREQ : 0;                  // LSERDY
+        case MCO1_HSE:
+        case MCO2_HSE:
+            return ((CR >> 17) & 1) ? RCC_HSE_FREQ : 0;                                  // HSERDY
+        case MCO2_SYSCLK:
+            return RCC_GetSysClkFreq();
+        case MCO2_PLLI2S:
+            if (((CR >> 27) & 1) == 0) {
+                return 0;  // PLLI2S not locked
+            }
+            Cfg = RCC_READ(RCC->PLLI2SCFGR);
+            return RCC_PllOutFreq(Cfg, (Cfg >> 28) & 0x7);                               // PLLI2SR
+        default:
+            if (((CR >> 25) & 1) == 0) {
+                return 0;  // PLL not locked
+            }
+            Cfg = RCC_READ(RCC->PLLCFGR);
+            return RCC_PllOutFreq(Cfg, (((Cfg >> 16) & 0x3) + 1) * 2);                   // PLLP
+    }
+}
+
+/**
+ * @brief Routes a clock to MCO1 (PA8) or MCO2 (PC9).
+ *
+ * The output frequency (source / Div) is checked against what the pin can drive at the
+ * requested speed (RCC_GPIO_*_MAX_FREQ) before anything is written. CFGR is updated in
+ * one read-modify-write, then the GPIO port clock is enabled and the pin switched to
+ * alternate function 0 (MCO) at the requested speed. The PLL outputs are computed from
+ * their current settings, so configure the PLL first.
+ *
+ * @param Src The clock and output to use (MCO1_HSI ... MCO2_PLL).
+ * @param Div The output prescaler (1..RCC_MCO_MAX_DIV).
+ * @param Speed The OSPEEDR setting of the pin.
+ * @return uint8_t Returns 0 on success, 1 for invalid arguments, a source that is not
+ *         ready or an output frequency too high for the pin speed.
+ */
+uint8_t RCC_MCO_Config(RCC_MCO_SRC_t Src, uint8_t Div, RCC_GPIO_SPEED_t Speed) {
+    static const uint32_t MaxFreq[4] = {
+        RCC_GPIO_LOW_MAX_FREQ, RCC_GPIO_MEDIUM_MAX_FREQ, RCC_GPIO_FAST_MAX_FREQ, RCC_GPIO_HIGH_MAX_FREQ
+    };
+    GPIO_RegDef_t *Port;
+    uint32_t       Pin;
+    uint32_t       Freq;
+    uint32_t       Pre;
+    uint32_t       Old;
+    uint32_t       New;
+    RCC_PROBE_ENTRY();
+
+    if ((unsigned)Src > MCO2_PLL || Div == 0 || Div > RCC_MCO_MAX_DIV || (unsigned)Speed > GPIO_SPEED_HIGH) {
+        RCC_PROBE_RETURN(RCC_OP_MCO_CONFIG, 1);
+    }
+    Freq = RCC_MCO_SrcFreq(Src) / Div;
+    if (Freq == 0 || Freq > MaxFreq[Speed]) {
+        RCC_PROBE_RETURN(RCC_OP_MCO_CONFIG, 1);  // The pin cannot follow this clock
+    }
+
+    // MCOxPRE: 0xx = /1, 100 = /2 ... 111 = /5
+    Pre = (Div == 1) ? 0 : (0x4 | (Div - 2));
+    Old = RCC_READ(RCC->CFGR);
+    if (Src < MCO2_SYSCLK) {
+        New = (Old & ~((0x3UL << 21) | (0x7UL << 24))) | ((uint32_t)Src << 21) | (Pre << 24);
+        Port = GPIOA;
+        Pin = 8;
+        (void)RCC_AHB1_EnableClk(GPIOAEN);
+    } else {
+        New = (Old & ~((0x3UL << 30) | (0x7UL << 27))) | ((uint32_t)(Src - MCO2_SYSCLK) << 30) | (Pre << 27);
+        Port = GPIOC;
+        Pin = 9;
+        (void)RCC_AHB1_EnableClk(GPIOCEN);
+    }
+    RCC_WRITE(RCC->CFGR, New);
+    RCC_TRACE_EVENT(RCC_OP_MCO_CONFIG, Src, CFGR, Old, New);
+
+    // AF0 at the requested speed, then alternate function mode
+    RCC_WRITE(Port->AFR[1], RCC_READ(Port->AFR[1]) & ~(0xFUL << ((Pin - 8) * 4)));
+    RCC_WRITE(Port->OSPEEDR, (RCC_READ(Port->OSPEEDR) & ~(0x3UL << (Pin * 2))) | ((uint32_t)Speed << (Pin * 2)));
+    RCC_WRITE(Port->MODER, (RCC_READ(Port->MODER) & ~(0x3UL << (Pin * 2))) | (0x2UL << (Pin * 2)));
+
+    RCC_PROBE_RETURN(RCC_OP_MCO_CONFIG, 0);  // Success
+}
+
+#if RCC_TRACE
+/**
+ * @brief Returns the clock event trace ring.
+ *
+ * Records are valid when Rec[i].Seq == claim index + 1; the newest record has index
+ * Head - 1 and lives in slot (Head - 1) % RCC_TRACE_DEPTH.
+ *
+ * @return const RCC_TRACE_t* Pointer to the live ring buffer.
+ */
+const RCC_TRACE_t *RCC_GetTrace(void) {
+    return &RCC_Trace;
+}
+
+/**
+ * @brief Empties the trace ring and starts the DWT cycle counter for timestamps.
+ */
+void RCC_ResetTrace(void) {
+    uint32_t Idx;
+
+    RCC_CycleCounterStart();
+    for (Idx = 0; Idx < RCC_TRACE_DEPTH; Idx++) {
+        RCC_Trace.Rec[Idx].Seq = 0;
+    }
+    RCC_Trace.Head = 0;
+}
+#endif
+
+#if RCC_INSTRUMENTATION
+/**
+ * @brief Returns the cycle statistics collected since the last RCC_ResetStats().
+ *
+ * @return const RCC_STATS_t* Pointer to the live statistics.
+ */
+const RCC_STATS_t *RCC_GetStats(void) {
+    return &RCC_Stats;
+}
+
+/**
+ * @brief Clears the cycle statistics and starts the DWT cycle counter.
+ */
+void RCC_ResetStats(void) {
+    uint32_t Idx;
+
+    RCC_CycleCounterStart();
+    RCC_WRITE(DWT->CYCCNT, 0);
+
+    for (Idx = 0; Idx < RCC_OP_COUNT; Idx++) {
+        RCC_Stats.Op[Idx].Count = 0;
+        RCC_Stats.Op[Idx].Last = 0;
+        RCC_Stats.Op[Idx].Min = 0;
+        RCC_Stats.Op[Idx].Max = 0;
+    }
+    for (Idx = 0; Idx < RCC_WAIT_COUNT; Idx++) {
+        RCC_Stats.Wait[Idx].Count = 0;
+        RCC_Stats.Wait[Idx].Last = 0;
+        RCC_Stats.Wait[Idx].Min = 0;
+        RCC_Stats.Wait[Idx].Max = 0;
+    }
 }
+#endif
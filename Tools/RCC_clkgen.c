@@ -0,0 +1,507 @@
+/*
+ * RCC_clkgen - board clock configuration generator (Linux host tool).
+ *
+ * Reads a small INI file describing the oscillators, the clock targets and the
+ * enabled peripherals of a board, solves the main PLL, checks the result with
+ * RCC_CFG_CHECK() and emits a header holding the final register words, so the
+ * boot code only stores precomputed values through RCC_LoadImage().
+ *
+ * Build:  gcc -std=c99 -O2 -Wall -I../Inc -o RCC_clkgen RCC_clkgen.c
+ * Usage:  RCC_clkgen boards/nucleo_f446re.ini > board_clk.h
+ *
+ * Recognised keys (see boards/ for a complete file):
+ *   [board]        name
+ *   [oscillators]  hse_freq, hse_mode (crystal | bypass), vdd_mv
+ *   [targets]      sysclk, sysclk_src (hsi | hse | pllp | pllr | auto), pll_src (hsi | hse),
+ *                  ahb_div, apb1_div, apb2_div (0 = smallest legal divider), use_48mhz
+ *   [peripherals]  enable (list of RCC_*_PERIPHERAL_t names, e.g. GPIOAEN, USART2EN)
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "RCC_private.h"
+
+#define LINE_MAX_LEN      256
+#define NAME_MAX_LEN      32
+
+#define PLLCFGR_RESET     0x24003010UL   // PLLCFGR reset value (M=16, N=192, P=2, Q=4, R=2)
+
+/********************* Peripheral Bus Identifiers *********************/
+typedef enum
+{
+    BUS_AHB1 = 0,
+    BUS_AHB2,
+    BUS_AHB3,
+    BUS_APB1,
+    BUS_APB2,
+    BUS_COUNT
+
+}BUS_t;
+
+typedef struct
+{
+    const char *Name;
+    BUS_t       Bus;
+    uint8_t     Bit;
+
+}PERIPHERAL_NAME_t;
+
+static const PERIPHERAL_NAME_t Peripherals[] = {
+    {"GPIOAEN", BUS_AHB1, GPIOAEN},   {"GPIOBEN", BUS_AHB1, GPIOBEN},   {"GPIOCEN", BUS_AHB1, GPIOCEN},
+    {"GPIODEN", BUS_AHB1, GPIODEN},   {"GPIOEEN", BUS_AHB1, GPIOEEN},   {"GPIOFEN", BUS_AHB1, GPIOFEN},
+    {"GPIOGEN", BUS_AHB1, GPIOGEN},   {"GPIOHEN", BUS_AHB1, GPIOHEN},   {"CRCEN", BUS_AHB1, CRCEN},
+    {"SRAM", BUS_AHB1, SRAM},         {"DMA1EN", BUS_AHB1, DMA1EN},     {"DMA2EN", BUS_AHB1, DMA2EN},
+    {"OTGHSEN", BUS_AHB1, OTGHSEN},   {"OTGHSULPIEN", BUS_AHB1, OTGHSULPIEN},
+    {"DCMIEN", BUS_AHB2, DCMIEN},     {"OTGFSEN", BUS_AHB2, OTGFSEN},
+    {"FMCEN", BUS_AHB3, FMCEN},       {"QSPIEN", BUS_AHB3, QSPIEN},
+    {"TIM2EN", BUS_APB1, TIM2EN},     {"TIM3EN", BUS_APB1, TIM3EN},     {"TIM4EN", BUS_APB1, TIM4EN},
+    {"TIM5EN", BUS_APB1, TIM5EN},     {"TIM6EN", BUS_APB1, TIM6EN},     {"TIM7EN", BUS_APB1, TIM7EN},
+    {"TIM12EN", BUS_APB1, TIM12EN},   {"TIM13EN", BUS_APB1, TIM13EN},   {"TIM14EN", BUS_APB1, TIM14EN},
+    {"WWDGEN", BUS_APB1, WWDGEN},     {"SPI2EN", BUS_APB1, SPI2EN},     {"SPI3EN", BUS_APB1, SPI3EN},
+    {"SPDIFRXEN", BUS_APB1, SPDIFRXEN}, {"USART2EN", BUS_APB1, USART2EN}, {"USART3EN", BUS_APB1, USART3EN},
+    {"UART4EN", BUS_APB1, UART4EN},   {"UART5EN", BUS_APB1, UART5EN},   {"I2C1EN", BUS_APB1, I2C1EN},
+    {"I2C2EN", BUS_APB1, I2C2EN},     {"I2C3EN", BUS_APB1, I2C3EN},     {"FMPI2C1EN", BUS_APB1, FMPI2C1EN},
+    {"CAN1EN", BUS_APB1, CAN1EN},     {"CAN2EN", BUS_APB1, CAN2EN},     {"CECEN", BUS_APB1, CECEN},
+    {"PWREN", BUS_APB1, PWREN},       {"DACEN", BUS_APB1, DACEN},
+    {"TIM1EN", BUS_APB2, TIM1EN},     {"TIM8EN", BUS_APB2, TIM8EN},     {"USART1EN", BUS_APB2, USART1EN},
+    {"USART6EN", BUS_APB2, USART6EN}, {"ADC1EN", BUS_APB2, ADC1EN},     {"ADC2EN", BUS_APB2, ADC2EN},
+    {"ADC3EN", BUS_APB2, ADC3EN},     {"SDIOEN", BUS_APB2, SDIOEN},     {"SPI1EN", BUS_APB2, SPI1EN},
+    {"SPI4EN", BUS_APB2, SPI4EN},     {"SYSCFGEN", BUS_APB2, SYSCFGEN}, {"TIM9EN", BUS_APB2, TIM9EN},
+    {"TIM10EN", BUS_APB2, TIM10EN},   {"TIM11EN", BUS_APB2, TIM11EN},   {"SAI1EN", BUS_APB2, SAI1EN},
+    {"SAI2EN", BUS_APB2, SAI2EN},
+};
+
+static const char *BusNames[BUS_COUNT] = {"AHB1ENR", "AHB2ENR", "AHB3ENR", "APB1ENR", "APB2ENR"};
+
+/********************* Board Description *********************/
+typedef struct
+{
+    char             Name[NAME_MAX_LEN];
+    uint32_t         SysClkTarget;   // Requested SYSCLK in Hz
+    uint32_t         VddMv;          // Supply voltage, selects the flash wait-state table
+    uint8_t          AutoSysClk;     // Pick PLLP or PLLR, whichever reaches the target
+    RCC_CLK_CONFIG_t Clk;
+    uint32_t         EnableMask[BUS_COUNT];
+
+}BOARD_t;
+
+/**
+ * @brief Removes leading and trailing white space in place.
+ */
+static char *Trim(char *Str) {
+    char *End;
+
+    while (isspace((unsigned char)*Str)) {
+        Str++;
+    }
+    End = Str + strlen(Str);
+    while (End > Str && isspace((unsigned char)End[-1])) {
+        End--;
+    }
+    *End = '\0';
+    return Str;
+}
+
+/**
+ * @brief Reports a configuration error and terminates the generator.
+ */
+static void Fail(const char *File, unsigned Line, const char *Msg, const char *Arg) {
+    fprintf(stderr, "%s:%u: %s '%s'\n", File, Line, Msg, Arg);
+    exit(1);
+}
+
+/**
+ * @brief Marks one peripheral (by its enumerator name) as enabled.
+ *
+ * @return int 0 on success, 1 if the name is unknown.
+ */
+static int EnablePeripheral(BOARD_t *Board, const char *Name) {
+    size_t Idx;
+
+    for (Idx = 0; Idx < sizeof(Peripherals) / sizeof(Peripherals[0]); Idx++) {
+        if (strcmp(Peripherals[Idx].Name, Name) == 0) {
+            Board->EnableMask[Peripherals[Idx].Bus] |= (1UL << Peripherals[Idx].Bit);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Parses the INI file into a board description.
+ */
+static void ParseBoard(const char *File, BOARD_t *Board) {
+    char     Buf[LINE_MAX_LEN];
+    char     Section[NAME_MAX_LEN] = "";
+    unsigned Line = 0;
+    FILE    *In = fopen(File, "r");
+
+    if (In == NULL) {
+        Fail(File, 0, "cannot open", File);
+    }
+
+    while (fgets(Buf, sizeof(Buf), In) != NULL) {
+        char *Key;
+        char *Val;
+        char *Eq;
+
+        Line++;
+        Key = Trim(Buf);
+        if (*Key == '\0' || *Key == ';' || *Key == '#') {
+            continue;
+        }
+        if (*Key == '[') {
+            char *Close = strchr(Key, ']');
+            if (Close == NULL || Close - Key - 1 >= NAME_MAX_LEN) {
+                Fail(File, Line, "bad section", Key);
+            }
+            *Close = '\0';
+            strcpy(Section, Key + 1);
+            continue;
+        }
+
+        Eq = strchr(Key, '=');
+        if (Eq == NULL) {
+            Fail(File, Line, "expected key = value", Key);
+        }
+        *Eq = '\0';
+        Key = Trim(Key);
+        Val = Trim(Eq + 1);
+
+        if (strcmp(Section, "board") == 0 && strcmp(Key, "name") == 0) {
+            snprintf(Board->Name, sizeof(Board->Name), "%s", Val);
+        } else if (strcmp(Section, "oscillators") == 0 && strcmp(Key, "hse_freq") == 0) {
+            Board->Clk.HSE_Freq = strtoul(Val, NULL, 0);
+        } else if (strcmp(Section, "oscillators") == 0 && strcmp(Key, "hse_mode") == 0) {
+            if (strcmp(Val, "bypass") == 0) {
+                Board->Clk.HSE_Mode = BYPASSED;
+            } else if (strcmp(Val, "crystal") == 0) {
+                Board->Clk.HSE_Mode = NOT_BYPASSED;
+            } else {
+                Fail(File, Line, "unknown hse_mode", Val);
+            }
+        } else if (strcmp(Section, "oscillators") == 0 && strcmp(Key, "vdd_mv") == 0) {
+            Board->VddMv = strtoul(Val, NULL, 0);
+        } else if (strcmp(Section, "targets") == 0 && strcmp(Key, "sysclk") == 0) {
+            Board->SysClkTarget = strtoul(Val, NULL, 0);
+        } else if (strcmp(Section, "targets") == 0 && strcmp(Key, "sysclk_src") == 0) {
+            Board->AutoSysClk = 0;
+            if (strcmp(Val, "hsi") == 0) {
+                Board->Clk.SysClk = SYSHSI;
+            } else if (strcmp(Val, "hse") == 0) {
+                Board->Clk.SysClk = SYSHSE;
+            } else if (strcmp(Val, "pllp") == 0) {
+                Board->Clk.SysClk = SYSPLLP;
+            } else if (strcmp(Val, "pllr") == 0) {
+                Board->Clk.SysClk = SYSPLLR;
+            } else if (strcmp(Val, "auto") == 0) {
+                Board->Clk.SysClk = SYSPLLP;
+                Board->AutoSysClk = 1;
+            } else {
+                Fail(File, Line, "unknown sysclk_src", Val);
+            }
+        } else if (strcmp(Section, "targets") == 0 && strcmp(Key, "pll_src") == 0) {
+            if (strcmp(Val, "hsi") == 0) {
+                Board->Clk.PLL.PLL_Src = HSI;
+            } else if (strcmp(Val, "hse") == 0) {
+                Board->Clk.PLL.PLL_Src = HSE;
+            } else {
+                Fail(File, Line, "unknown pll_src", Val);
+            }
+        } else if (strcmp(Section, "targets") == 0 && strcmp(Key, "ahb_div") == 0) {
+            Board->Clk.AHB_Div = (uint16_t)strtoul(Val, NULL, 0);
+        } else if (strcmp(Section, "targets") == 0 && strcmp(Key, "apb1_div") == 0) {
+            Board->Clk.APB1_Div = (uint8_t)strtoul(Val, NULL, 0);
+        } else if (strcmp(Section, "targets") == 0 && strcmp(Key, "apb2_div") == 0) {
+            Board->Clk.APB2_Div = (uint8_t)strtoul(Val, NULL, 0);
+        } else if (strcmp(Section, "targets") == 0 && strcmp(Key, "use_48mhz") == 0) {
+            Board->Clk.Use48MHz = (uint8_t)(strtoul(Val, NULL, 0) != 0);
+        } else if (strcmp(Section, "peripherals") == 0 && strcmp(Key, "enable") == 0) {
+            char *Tok;
+            for (Tok = strtok(Val, ", \t"); Tok != NULL; Tok = strtok(NULL, ", \t")) {
+                if (EnablePeripheral(Board, Tok) != 0) {
+                    Fail(File, Line, "unknown peripheral", Tok);
+                }
+            }
+        } else {
+            Fail(File, Line, "unknown key", Key);
+        }
+    }
+    fclose(In);
+}
+
+/**
+ * @brief Searches PLLM/PLLN/PLLP/PLLQ/PLLR for the requested SYSCLK.
+ *
+ * Candidates must pass RCC_CFG_CHECK() for the PLL part. The best candidate has the
+ * smallest SYSCLK error (never above target), then an exact 48 MHz output, then the
+ * highest VCO input frequency (lowest PLL jitter).
+ *
+ * @return int 0 on success, 1 if no PLL setting reaches a legal SYSCLK.
+ */
+static int SolvePLL(BOARD_t *Board) {
+    RCC_CLK_CONFIG_t *Clk = &Board->Clk;
+    unsigned long long InFreq = RCC_PLL_IN_FREQ(Clk->HSE_Freq, Clk->PLL.PLL_Src);
+    unsigned long long BestErr = ~0ULL;
+    unsigned long long BestCk48Err = ~0ULL;
+    unsigned long long BestVcoIn = 0;
+    PLL_CONFIG_t       Best = Clk->PLL;
+    SYS_CLK_t          BestSys = Clk->SysClk;
+    uint32_t           M;
+    uint32_t           N;
+    uint32_t           Div;
+    int                Found = 0;
+    int                Pass;
+
+    for (Pass = 0; Pass < 2; Pass++) {
+        SYS_CLK_t Sys = (Pass == 0) ? SYSPLLP : SYSPLLR;
+
+        if (!Board->AutoSysClk && Sys != Clk->SysClk) {
+            continue;
+        }
+        for (M = 2; M <= 63; M++) {
+            unsigned long long VcoIn = InFreq / M;
+
+            if (VcoIn < RCC_VCO_IN_MIN_FREQ || VcoIn > RCC_VCO_IN_MAX_FREQ) {
+                continue;
+            }
+            for (N = 50; N <= 432; N++) {
+                unsigned long long Vco = RCC_VCO_OUT_FREQ(Clk->HSE_Freq, Clk->PLL.PLL_Src, M, N);
+
+                if (Vco < RCC_VCO_OUT_MIN_FREQ || Vco > RCC_VCO_OUT_MAX_FREQ) {
+                    continue;
+                }
+                for (Div = 2; Div <= 8; Div++) {
+                    unsigned long long SysFreq = Vco / Div;
+                    unsigned long long Err;
+                    unsigned long long Ck48Err = 0;
+                    // Keep the 48 MHz domain at or below 48 MHz even when unused
+                    uint32_t           Q = (uint32_t)((Vco + RCC_CK48_FREQ - 1) / RCC_CK48_FREQ);
+
+                    if ((Sys == SYSPLLP && !RCC_IS_PLLP_DIV(Div)) || (Sys == SYSPLLR && Div > 7) ||
+                        SysFreq > Board->SysClkTarget || SysFreq > RCC_SYSCLK_MAX_FREQ) {
+                        continue;
+                    }
+                    Err = Board->SysClkTarget - SysFreq;
+                    if (Q > 15) {
+                        Q = 15;
+                    }
+
+                    if (Clk->Use48MHz) {
+                        // Closest PLLQ to 48 MHz for this VCO
+                        Q = (uint32_t)((Vco + RCC_CK48_FREQ / 2) / RCC_CK48_FREQ);
+                        if (Q < 2 || Q > 15) {
+                            continue;
+                        }
+                        Ck48Err = (Vco / Q > RCC_CK48_FREQ) ? Vco / Q - RCC_CK48_FREQ : RCC_CK48_FREQ - Vco / Q;
+                        if (Ck48Err > RCC_CK48_TOLERANCE) {
+                            continue;
+                        }
+                    }
+
+                    if (Err < BestErr ||
+                        (Err == BestErr && Ck48Err < BestCk48Err) ||
+                        (Err == BestErr && Ck48Err == BestCk48Err && VcoIn > BestVcoIn)) {
+                        BestErr = Err;
+                        BestCk48Err = Ck48Err;
+                        BestVcoIn = VcoIn;
+                        BestSys = Sys;
+                        Best.PLL_M = (uint8_t)M;
+                        Best.PLL_N = (uint16_t)N;
+                        Best.PLL_P = (uint8_t)((Sys == SYSPLLP) ? Div : 2);
+                        Best.PLL_R = (uint8_t)((Sys == SYSPLLR) ? Div : 2);
+                        Best.PLL_Q = (uint8_t)Q;
+                        Found = 1;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!Found) {
+        return 1;
+    }
+    Clk->PLL = Best;
+    Clk->SysClk = BestSys;
+    return 0;
+}
+
+/**
+ * @brief Picks the smallest APB divider that keeps the bus under its ceiling.
+ */
+static uint8_t PickAPBDiv(unsigned long long HClk, unsigned long MaxFreq) {
+    uint8_t Div;
+
+    for (Div = 1; Div < 16 && HClk / Div > MaxFreq; Div = (uint8_t)(Div * 2)) {
+    }
+    return Div;
+}
+
+/**
+ * @brief Encodes the AHB prescaler into CFGR.HPRE.
+ */
+static uint32_t EncodeHPRE(uint16_t Div) {
+    switch (Div) {
+        case 2:   return 0x8;
+        case 4:   return 0x9;
+        case 8:   return 0xA;
+        case 16:  return 0xB;
+        case 64:  return 0xC;
+        case 128: return 0xD;
+        case 256: return 0xE;
+        case 512: return 0xF;
+        default:  return 0x0;
+    }
+}
+
+/**
+ * @brief Encodes an APB prescaler into CFGR.PPRE1/PPRE2.
+ */
+static uint32_t EncodePPRE(uint8_t Div) {
+    switch (Div) {
+        case 2:  return 0x4;
+        case 4:  return 0x5;
+        case 8:  return 0x6;
+        case 16: return 0x7;
+        default: return 0x0;
+    }
+}
+
+/**
+ * @brief Flash wait states for a given HCLK and supply voltage (DS10693 table 17).
+ */
+static uint32_t FlashLatency(unsigned long long HClk, uint32_t VddMv) {
+    unsigned long long PerWs;
+
+    if (VddMv >= 2700) {
+        PerWs = 30000000ULL;
+    } else if (VddMv >= 2400) {
+        PerWs = 24000000ULL;
+    } else if (VddMv >= 2100) {
+        PerWs = 22000000ULL;
+    } else {
+        PerWs = 20000000ULL;
+    }
+    return (HClk == 0) ? 0 : (uint32_t)((HClk - 1) / PerWs);
+}
+
+int main(int argc, char **argv) {
+    BOARD_t            Board;
+    RCC_CLK_CONFIG_t  *Clk = &Board.Clk;
+    unsigned long long SysFreq;
+    unsigned long long HClk;
+    uint32_t           Violations;
+    uint32_t           CR = 0;
+    uint32_t           PLLCFGR = PLLCFGR_RESET;
+    uint32_t           CFGR;
+    uint32_t           ACR;
+    int                Bus;
+    int                PLLUsed;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <board.ini>\n", argv[0]);
+        return 2;
+    }
+
+    memset(&Board, 0, sizeof(Board));
+    strcpy(Board.Name, "BOARD");
+    Board.VddMv = 3300;
+    Board.AutoSysClk = 1;
+    Clk->SysClk = SYSPLLP;
+    Clk->AHB_Div = 1;
+    Clk->PLL.PLL_Src = HSE;
+    Clk->PLL.PLL_Q = 4;
+    Clk->PLL.PLL_R = 2;
+    Clk->PLL.PLL_P = 2;
+    ParseBoard(argv[1], &Board);
+
+    if (Clk->HSE_Freq == 0 && Clk->PLL.PLL_Src == HSE) {
+        Clk->PLL.PLL_Src = HSI;  // No crystal fitted: run the PLL from HSI
+    }
+
+    PLLUsed = RCC_CFG_PLL_USED(Clk->SysClk, Clk->Use48MHz);
+    if (PLLUsed && Clk->SysClk != SYSPLLP && Clk->SysClk != SYSPLLR) {
+        fprintf(stderr, "%s: use_48mhz needs the PLL as system clock source\n", argv[1]);
+        return 1;
+    }
+    if (PLLUsed && SolvePLL(&Board) != 0) {
+        fprintf(stderr, "%s: no PLL setting reaches %lu Hz\n", argv[1], (unsigned long)Board.SysClkTarget);
+        return 1;
+    }
+
+    SysFreq = RCC_SYSCLK_CFG_FREQ(Clk->HSE_Freq, Clk->PLL.PLL_Src, Clk->PLL.PLL_M, Clk->PLL.PLL_N,
+                                  Clk->PLL.PLL_P, Clk->PLL.PLL_R, Clk->SysClk);
+    HClk = RCC_IS_AHB_DIV(Clk->AHB_Div) ? SysFreq / Clk->AHB_Div : SysFreq;
+    if (Clk->APB1_Div == 0) {
+        Clk->APB1_Div = PickAPBDiv(HClk, RCC_APB1_MAX_FREQ);
+    }
+    if (Clk->APB2_Div == 0) {
+        Clk->APB2_Div = PickAPBDiv(HClk, RCC_APB2_MAX_FREQ);
+    }
+
+    Violations = RCC_CFG_CHECK(Clk->HSE_Freq, Clk->HSE_Mode, Clk->PLL.PLL_Src, Clk->PLL.PLL_M,
+                               Clk->PLL.PLL_N, Clk->PLL.PLL_P, Clk->PLL.PLL_Q, Clk->PLL.PLL_R,
+                               Clk->SysClk, Clk->AHB_Div, Clk->APB1_Div, Clk->APB2_Div, Clk->Use48MHz);
+    if (Violations != 0) {
+        fprintf(stderr, "%s: configuration violates RCC_CFG_ERR_t mask 0x%05lX\n",
+                argv[1], (unsigned long)Violations);
+        return 1;
+    }
+
+    // Oscillators the boot code has to start
+    if (RCC_CFG_HSE_USED(Clk->PLL.PLL_Src, Clk->SysClk, Clk->Use48MHz)) {
+        CR |= (1UL << 16);
+        if (Clk->HSE_Mode == BYPASSED) {
+            CR |= (1UL << 18);
+        }
+    }
+    if (PLLUsed) {
+        CR |= (1UL << 24);
+        PLLCFGR = ((uint32_t)Clk->PLL.PLL_M << 0) |
+                  ((uint32_t)Clk->PLL.PLL_N << 6) |
+                  ((uint32_t)(Clk->PLL.PLL_P / 2 - 1) << 16) |
+                  ((Clk->PLL.PLL_Src == HSE) ? (1UL << 22) : 0) |
+                  ((uint32_t)Clk->PLL.PLL_Q << 24) |
+                  ((uint32_t)Clk->PLL.PLL_R << 28);
+    }
+    CFGR = ((uint32_t)Clk->SysClk << 0) |
+           (EncodeHPRE(Clk->AHB_Div) << 4) |
+           (EncodePPRE(Clk->APB1_Div) << 10) |
+           (EncodePPRE(Clk->APB2_Div) << 13);
+    // LATENCY plus prefetch, instruction and data caches
+    ACR = FlashLatency(HClk, Board.VddMv) | (1UL << 8) | (1UL << 9) | (1UL << 10);
+
+    printf("/* Generated by RCC_clkgen from %s -- do not edit. */\n", argv[1]);
+    printf("#ifndef %s_CLK_H\n#define %s_CLK_H\n\n", Board.Name, Board.Name);
+    printf("/* PLLM=%u PLLN=%u PLLP=%u PLLQ=%u PLLR=%u, source %s */\n",
+           Clk->PLL.PLL_M, Clk->PLL.PLL_N, Clk->PLL.PLL_P, Clk->PLL.PLL_Q, Clk->PLL.PLL_R,
+           (Clk->PLL.PLL_Src == HSE) ? "HSE" : "HSI");
+    printf("#define %s_HSE_FREQ           %luUL\n", Board.Name, (unsigned long)Clk->HSE_Freq);
+    printf("#define %s_SYSCLK_FREQ        %lluUL\n", Board.Name, SysFreq);
+    printf("#define %s_HCLK_FREQ          %lluUL\n", Board.Name, HClk);
+    printf("#define %s_PCLK1_FREQ         %lluUL\n", Board.Name, HClk / Clk->APB1_Div);
+    printf("#define %s_PCLK2_FREQ         %lluUL\n\n", Board.Name, HClk / Clk->APB2_Div);
+    printf("#define %s_RCC_CR             0x%08lXUL   /* Oscillators to start */\n", Board.Name, (unsigned long)CR);
+    printf("#define %s_RCC_PLLCFGR        0x%08lXUL\n", Board.Name, (unsigned long)PLLCFGR);
+    printf("#define %s_RCC_CFGR           0x%08lXUL\n", Board.Name, (unsigned long)CFGR);
+    printf("#define %s_RCC_DCKCFGR        0x%08lXUL\n", Board.Name, 0UL);
+    printf("#define %s_RCC_DCKCFGR2       0x%08lXUL\n", Board.Name, 0UL);
+    for (Bus = 0; Bus < BUS_COUNT; Bus++) {
+        printf("#define %s_RCC_%-14s 0x%08lXUL\n", Board.Name, BusNames[Bus], (unsigned long)Board.EnableMask[Bus]);
+    }
+    printf("#define %s_FLASH_ACR          0x%08lXUL\n", Board.Name, (unsigned long)ACR);
+    printf("#define %s_PWR_OVERDRIVE      %dU         /* HCLK above 168 MHz */\n\n",
+           Board.Name, HClk > 168000000ULL);
+    printf("/* Initializer for RCC_IMAGE_t, pass the result to RCC_LoadImage() */\n");
+    printf("#define %s_RCC_IMAGE_INIT  { %s_RCC_CR, %s_RCC_PLLCFGR, %s_RCC_CFGR, \\\n", Board.Name,
+           Board.Name, Board.Name, Board.Name);
+    printf("    %s_RCC_DCKCFGR, %s_RCC_DCKCFGR2, %s_RCC_AHB1ENR, %s_RCC_AHB2ENR, \\\n", Board.Name,
+           Board.Name, Board.Name, Board.Name);
+    printf("    %s_RCC_AHB3ENR, %s_RCC_APB1ENR, %s_RCC_APB2ENR, %s_FLASH_ACR, %s_PWR_OVERDRIVE }\n\n",
+           Board.Name, Board.Name, Board.Name, Board.Name, Board.Name);
+    printf("#endif /* %s_CLK_H */\n", Board.Name);
+
+    return 0;
+}
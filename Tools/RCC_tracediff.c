@@ -0,0 +1,277 @@
+/*
+ * RCC_tracediff - dump and compare RCC register access traces (Linux host tool).
+ *
+ * Reads the binary traces written by the host simulator (RCCSim_TraceOpen(), or
+ * RCC_bench --record) and compares a run against a golden trace. By default only the
+ * writes are compared, in order, since the number of ready-flag polls legitimately
+ * varies; --all compares the reads as well.
+ *
+ * Build:  gcc -std=c99 -O2 -Wall -I../Sim -I../Inc -I.. -o RCC_tracediff RCC_tracediff.c
+ * Usage:  RCC_tracediff --dump trace.rct
+ *         RCC_tracediff [--all] golden.rct run.rct
+ *
+ * The exit status is 0 when the traces match, 1 when they differ and 2 on an I/O or
+ * format error. For a mismatch the first diverging access is printed with its
+ * neighbours, followed by the per-register write counts of both traces.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "RCC_sim.h"
+
+#define CONTEXT_RECORDS    3U
+
+typedef struct
+{
+    uint32_t Seq;
+    uint32_t Addr;    // Physical address, write flag removed
+    uint32_t Value;
+    uint8_t  Write;
+
+}TRACE_REC_t;
+
+typedef struct
+{
+    TRACE_REC_t *Rec;
+    size_t       Count;
+
+}TRACE_t;
+
+typedef struct
+{
+    uint32_t    Addr;
+    const char *Name;
+
+}REG_NAME_t;
+
+static const REG_NAME_t RegNames[] = {
+    {RCC_BASE_ADDRESS + 0x00, "RCC_CR"},
+    {RCC_BASE_ADDRESS + 0x04, "RCC_PLLCFGR"},
+    {RCC_BASE_ADDRESS + 0x08, "RCC_CFGR"},
+    {RCC_BASE_ADDRESS + 0x0C, "RCC_CIR"},
+    {RCC_BASE_ADDRESS + 0x10, "RCC_AHB1RSTR"},
+    {RCC_BASE_ADDRESS + 0x14, "RCC_AHB2RSTR"},
+    {RCC_BASE_ADDRESS + 0x18, "RCC_AHB3RSTR"},
+    {RCC_BASE_ADDRESS + 0x20, "RCC_APB1RSTR"},
+    {RCC_BASE_ADDRESS + 0x24, "RCC_APB2RSTR"},
+    {RCC_BASE_ADDRESS + 0x30, "RCC_AHB1ENR"},
+    {RCC_BASE_ADDRESS + 0x34, "RCC_AHB2ENR"},
+    {RCC_BASE_ADDRESS + 0x38, "RCC_AHB3ENR"},
+    {RCC_BASE_ADDRESS + 0x40, "RCC_APB1ENR"},
+    {RCC_BASE_ADDRESS + 0x44, "RCC_APB2ENR"},
+    {RCC_BASE_ADDRESS + 0x50, "RCC_AHB1LPENR"},
+    {RCC_BASE_ADDRESS + 0x54, "RCC_AHB2LPENR"},
+    {RCC_BASE_ADDRESS + 0x58, "RCC_AHB3LPENR"},
+    {RCC_BASE_ADDRESS + 0x60, "RCC_APB1LPENR"},
+    {RCC_BASE_ADDRESS + 0x64, "RCC_APB2LPENR"},
+    {RCC_BASE_ADDRESS + 0x70, "RCC_BDCR"},
+    {RCC_BASE_ADDRESS + 0x74, "RCC_CSR"},
+    {RCC_BASE_ADDRESS + 0x80, "RCC_SSCGR"},
+    {RCC_BASE_ADDRESS + 0x84, "RCC_PLLI2SCFGR"},
+    {RCC_BASE_ADDRESS + 0x88, "RCC_PLLSAICFGR"},
+    {RCC_BASE_ADDRESS + 0x8C, "RCC_DCKCFGR"},
+    {RCC_BASE_ADDRESS + 0x90, "RCC_CKGATENR"},
+    {RCC_BASE_ADDRESS + 0x94, "RCC_DCKCFGR2"},
+    {FLASH_R_BASE_ADDRESS + 0x00, "FLASH_ACR"},
+    {PWR_BASE_ADDRESS + 0x00, "PWR_CR"},
+    {PWR_BASE_ADDRESS + 0x04, "PWR_CSR"},
+    {TIM5_BASE_ADDRESS + 0x00, "TIM5_CR1"},
+    {TIM5_BASE_ADDRESS + 0x10, "TIM5_SR"},
+    {TIM5_BASE_ADDRESS + 0x1C, "TIM5_CCMR2"},
+    {TIM5_BASE_ADDRESS + 0x20, "TIM5_CCER"},
+    {TIM5_BASE_ADDRESS + 0x40, "TIM5_CCR4"},
+    {TIM5_BASE_ADDRESS + 0x50, "TIM5_OR"},
+    {TIM11_BASE_ADDRESS + 0x00, "TIM11_CR1"},
+    {TIM11_BASE_ADDRESS + 0x10, "TIM11_SR"},
+    {TIM11_BASE_ADDRESS + 0x18, "TIM11_CCMR1"},
+    {TIM11_BASE_ADDRESS + 0x20, "TIM11_CCER"},
+    {TIM11_BASE_ADDRESS + 0x34, "TIM11_CCR1"},
+    {TIM11_BASE_ADDRESS + 0x50, "TIM11_OR"},
+    {GPIOA_BASE_ADDRESS + 0x00, "GPIOA_MODER"},
+    {GPIOA_BASE_ADDRESS + 0x08, "GPIOA_OSPEEDR"},
+    {GPIOA_BASE_ADDRESS + 0x24, "GPIOA_AFRH"},
+    {GPIOC_BASE_ADDRESS + 0x00, "GPIOC_MODER"},
+    {GPIOC_BASE_ADDRESS + 0x08, "GPIOC_OSPEEDR"},
+    {GPIOC_BASE_ADDRESS + 0x24, "GPIOC_AFRH"},
+};
+
+#define REG_NAME_COUNT    (sizeof(RegNames) / sizeof(RegNames[0]))
+
+static const char *RegName(uint32_t Addr) {
+    static char Unknown[16];
+    size_t      Idx;
+
+    for (Idx = 0; Idx < REG_NAME_COUNT; Idx++) {
+        if (RegNames[Idx].Addr == Addr) {
+            return RegNames[Idx].Name;
+        }
+    }
+    snprintf(Unknown, sizeof(Unknown), "0x%08lX", (unsigned long)Addr);
+    return Unknown;
+}
+
+static uint32_t GetU32(const uint8_t *Buf) {
+    return (uint32_t)Buf[0] | ((uint32_t)Buf[1] << 8) | ((uint32_t)Buf[2] << 16) | ((uint32_t)Buf[3] << 24);
+}
+
+/**
+ * @brief Loads a trace file; only the writes are kept unless KeepReads is set.
+ */
+static int LoadTrace(const char *Path, int KeepReads, TRACE_t *Trace) {
+    uint8_t Buf[RCCSIM_TRACE_REC_SIZE];
+    size_t  Capacity = 0;
+    FILE   *In = fopen(Path, "rb");
+
+    Trace->Rec = NULL;
+    Trace->Count = 0;
+    if (In == NULL) {
+        fprintf(stderr, "cannot open %s\n", Path);
+        return 1;
+    }
+    if (fread(Buf, RCCSIM_TRACE_HDR_SIZE, 1, In) != 1 || memcmp(Buf, RCCSIM_TRACE_MAGIC, 4) != 0 ||
+        GetU32(&Buf[4]) != RCCSIM_TRACE_VERSION) {
+        fprintf(stderr, "%s: not an RCC trace (version %u expected)\n", Path, RCCSIM_TRACE_VERSION);
+        fclose(In);
+        return 1;
+    }
+
+    while (fread(Buf, RCCSIM_TRACE_REC_SIZE, 1, In) == 1) {
+        uint32_t Addr = GetU32(&Buf[4]);
+
+        if (!KeepReads && (Addr & RCCSIM_TRACE_WRITE) == 0) {
+            continue;
+        }
+        if (Trace->Count == Capacity) {
+            Capacity = (Capacity == 0) ? 256 : Capacity * 2;
+            Trace->Rec = realloc(Trace->Rec, Capacity * sizeof(TRACE_REC_t));
+            if (Trace->Rec == NULL) {
+                fprintf(stderr, "out of memory\n");
+                fclose(In);
+                return 1;
+            }
+        }
+        Trace->Rec[Trace->Count].Seq = GetU32(&Buf[0]);
+        Trace->Rec[Trace->Count].Addr = Addr & ~RCCSIM_TRACE_WRITE;
+        Trace->Rec[Trace->Count].Value = GetU32(&Buf[8]);
+        Trace->Rec[Trace->Count].Write = (uint8_t)(Addr & RCCSIM_TRACE_WRITE);
+        Trace->Count++;
+    }
+    fclose(In);
+    return 0;
+}
+
+static void PrintRec(const char *Tag, const TRACE_REC_t *Rec) {
+    printf("%s %6lu  %c  %-15s 0x%08lX\n", Tag, (unsigned long)Rec->Seq, Rec->Write ? 'W' : 'R',
+           RegName(Rec->Addr), (unsigned long)Rec->Value);
+}
+
+static int SameAccess(const TRACE_REC_t *A, const TRACE_REC_t *B) {
+    return A->Addr == B->Addr && A->Value == B->Value && A->Write == B->Write;
+}
+
+static size_t CountWrites(const TRACE_t *Trace, uint32_t Addr) {
+    size_t Count = 0;
+    size_t Idx;
+
+    for (Idx = 0; Idx < Trace->Count; Idx++) {
+        if (Trace->Rec[Idx].Write && Trace->Rec[Idx].Addr == Addr) {
+            Count++;
+        }
+    }
+    return Count;
+}
+
+/**
+ * @brief Prints the per-register write counts; returns non-zero if any differ.
+ */
+static int CompareWriteCounts(const TRACE_t *Golden, const TRACE_t *Run) {
+    int    Differ = 0;
+    size_t Idx;
+    size_t G;
+    size_t R;
+
+    printf("\n%-15s %8s %8s\n", "register", "golden", "run");
+    for (Idx = 0; Idx < REG_NAME_COUNT; Idx++) {
+        G = CountWrites(Golden, RegNames[Idx].Addr);
+        R = CountWrites(Run, RegNames[Idx].Addr);
+        if (G != 0 || R != 0) {
+            printf("%-15s %8lu %8lu%s\n", RegNames[Idx].Name, (unsigned long)G, (unsigned long)R,
+                   (G != R) ? "  <-- changed" : "");
+        }
+        Differ |= (G != R);
+    }
+    return Differ;
+}
+
+static int Dump(const char *Path) {
+    TRACE_t Trace;
+    size_t  Idx;
+
+    if (LoadTrace(Path, 1, &Trace) != 0) {
+        return 2;
+    }
+    for (Idx = 0; Idx < Trace.Count; Idx++) {
+        PrintRec("", &Trace.Rec[Idx]);
+    }
+    free(Trace.Rec);
+    return 0;
+}
+
+static int Diff(const char *GoldenPath, const char *RunPath, int All) {
+    TRACE_t Golden;
+    TRACE_t Run;
+    size_t  Idx = 0;
+    size_t  From;
+    size_t  To;
+    int     Result = 0;
+
+    if (LoadTrace(GoldenPath, All, &Golden) != 0 || LoadTrace(RunPath, All, &Run) != 0) {
+        return 2;
+    }
+
+    while (Idx < Golden.Count && Idx < Run.Count && SameAccess(&Golden.Rec[Idx], &Run.Rec[Idx])) {
+        Idx++;
+    }
+
+    if (Idx == Golden.Count && Idx == Run.Count) {
+        printf("match: %lu %s\n", (unsigned long)Idx, All ? "accesses" : "writes");
+    } else {
+        Result = 1;
+        printf("first difference at %s #%lu\n", All ? "access" : "write", (unsigned long)Idx);
+        From = (Idx > CONTEXT_RECORDS) ? Idx - CONTEXT_RECORDS : 0;
+        To = Idx + CONTEXT_RECORDS + 1;
+        for (; From < To; From++) {
+            if (From < Golden.Count) {
+                PrintRec((From == Idx) ? "- >" : "-  ", &Golden.Rec[From]);
+            }
+            if (From < Run.Count) {
+                PrintRec((From == Idx) ? "+ >" : "+  ", &Run.Rec[From]);
+            }
+        }
+        printf("golden: %lu, run: %lu\n", (unsigned long)Golden.Count, (unsigned long)Run.Count);
+    }
+
+    if (CompareWriteCounts(&Golden, &Run) != 0) {
+        Result = 1;
+    }
+
+    free(Golden.Rec);
+    free(Run.Rec);
+    return Result;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "--dump") == 0) {
+        return Dump(argv[2]);
+    }
+    if (argc == 3) {
+        return Diff(argv[1], argv[2], 0);
+    }
+    if (argc == 4 && strcmp(argv[1], "--all") == 0) {
+        return Diff(argv[2], argv[3], 1);
+    }
+
+    fprintf(stderr, "usage: %s --dump trace.rct\n       %s [--all] golden.rct run.rct\n", argv[0], argv[0]);
+    return 2;
+}